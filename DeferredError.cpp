@@ -0,0 +1,254 @@
+/*
+ * 	Copyright (C) 2023 Philipp Rimmele & Valentin Felder
+ *
+ *	Redistribution and use in source and binary forms, with or without modification, are
+ *	permitted provided that the following conditions are met:
+ *
+ * 	1. Redistributions of source code must retain the above copyright notice, this list
+ *     of conditions and the following disclaimer.
+ *
+ * 	2. Redistributions in binary form must reproduce the above copyright notice, this
+ *     list of conditions and the following disclaimer in the documentation and/or
+ *     other materials provided with the distribution.
+ *
+ *	3. Neither the name of the copyright holder nor the names of its contributors
+ * 	   may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	“AS IS” AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *	TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *	PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *	HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *	SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *	LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *	DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *	THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *	(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ *	THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "DeferredError.hpp"
+
+extern "C"
+{
+extern const SlimExcLib::MessageRecord __start_slimexc_messages[] __attribute__((weak, visibility("hidden")));
+extern const SlimExcLib::MessageRecord __stop_slimexc_messages[] __attribute__((weak, visibility("hidden")));
+}
+
+namespace SlimExcLib
+{
+
+namespace
+{
+
+// Appends characters like snprintf: counts all of them, but only writes as much as fits.
+class FormatWriter
+{
+private:
+	char* buffer;
+	size_t size;
+	size_t length = 0;
+
+public:
+	FormatWriter(char* buffer, size_t size) noexcept : buffer(buffer), size(size) {}
+
+	void put(char character) noexcept
+	{
+		if (this->length + 1 < this->size)
+		{
+			this->buffer[this->length] = character;
+		}
+		this->length++;
+	}
+
+	void put(const char* text) noexcept
+	{
+		for (; *text != '\0'; text++)
+		{
+			this->put(*text);
+		}
+	}
+
+	void putUnsigned(uint64_t value, uint8_t base = 10) noexcept
+	{
+		char digits[20];
+		uint8_t count = 0;
+		do
+		{
+			uint8_t digit = value % base;
+			digits[count++] = (digit < 10) ? ('0' + digit) : ('a' + digit - 10);
+			value /= base;
+		} while (value != 0);
+
+		while (count > 0)
+		{
+			this->put(digits[--count]);
+		}
+	}
+
+	void putSigned(int64_t value) noexcept
+	{
+		if (value < 0)
+		{
+			this->put('-');
+			this->putUnsigned(0 - static_cast<uint64_t>(value));
+		}
+		else
+		{
+			this->putUnsigned(static_cast<uint64_t>(value));
+		}
+	}
+
+	void putDecimals(uint64_t fraction) noexcept
+	{
+		for (uint64_t divisor = 100000; divisor > 0; divisor /= 10)
+		{
+			this->put('0' + (fraction / divisor) % 10);
+		}
+	}
+
+	void putFloatingPoint(double value) noexcept
+	{
+		if (value != value)
+		{
+			this->put("nan");
+			return;
+		}
+		if (value < 0)
+		{
+			this->put('-');
+			value = -value;
+		}
+		if (value - value != value - value)
+		{
+			this->put("inf");
+			return;
+		}
+
+		if (value >= 18446744073709551616.0)
+		{//Integral part does not fit into 64 bits: exponent notation with 6 decimals (like "%e")
+			uint32_t exponent = 0;
+			for (; value >= 1e16; exponent += 16)
+			{
+				value /= 1e16;
+			}
+			for (; value >= 10.0; exponent++)
+			{
+				value /= 10.0;
+			}
+			uint64_t digits = static_cast<uint64_t>(value * 1000000.0 + 0.5);
+			if (digits >= 10000000)
+			{
+				digits /= 10;
+				exponent++;
+			}
+			this->put('0' + digits / 1000000);
+			this->put('.');
+			this->putDecimals(digits % 1000000);
+			this->put(exponent < 10 ? "e+0" : "e+");
+			this->putUnsigned(exponent);
+			return;
+		}
+
+		//Fixed notation with 6 decimals (like "%f")
+		uint64_t integral = static_cast<uint64_t>(value);
+		uint64_t fraction = static_cast<uint64_t>((value - integral) * 1000000.0 + 0.5);
+		if (fraction >= 1000000)
+		{
+			integral++;
+			fraction -= 1000000;
+		}
+		this->putUnsigned(integral);
+		this->put('.');
+		this->putDecimals(fraction);
+	}
+
+	size_t finish() noexcept
+	{
+		if (this->size > 0)
+		{
+			this->buffer[(this->length < this->size) ? this->length : this->size - 1] = '\0';
+		}
+		return this->length;
+	}
+};
+
+template <class T> T readArgument(const unsigned char* bytes, size_t& offset) noexcept
+{
+	T value;
+	unsigned char* target = reinterpret_cast<unsigned char*>(&value);
+	for (size_t i = 0; i < sizeof(T); i++)
+	{
+		target[i] = bytes[offset++];
+	}
+	return value;
+}
+
+}//Endnamespace
+
+const MessageRecord* DeferredError::getRecord() const noexcept
+{
+	uint32_t id = this->getId();
+	for (const MessageRecord* record = __start_slimexc_messages; record != __stop_slimexc_messages; record++)
+	{
+		if (record->id == id)
+		{
+			return record;
+		}
+	}
+	return NULL;
+}
+
+size_t DeferredError::format(char* buffer, size_t size) const noexcept
+{
+	FormatWriter writer(buffer, size);
+
+	const MessageRecord* record = this->getRecord();
+	if (record == NULL)
+	{
+		writer.put("<unregistered message 0x");
+		writer.putUnsigned(this->getId(), 16);
+		writer.put('>');
+		return writer.finish();
+	}
+
+	uintptr_t kinds = record->argumentKinds;
+	size_t offset = idSize;
+	for (const char* text = record->text; *text != '\0'; text++)
+	{
+		if ((text[0] != '{') || (text[1] != '}') || ((kinds & 0xF) == END))
+		{
+			writer.put(*text);
+			continue;
+		}
+		text++;
+
+		switch (static_cast<Kind>(kinds & 0xF))
+		{
+		case SIGNED8:	writer.putSigned(readArgument<int8_t>(this->data, offset)); break;
+		case SIGNED16:	writer.putSigned(readArgument<int16_t>(this->data, offset)); break;
+		case SIGNED32:	writer.putSigned(readArgument<int32_t>(this->data, offset)); break;
+		case SIGNED64:	writer.putSigned(readArgument<int64_t>(this->data, offset)); break;
+		case UNSIGNED8:	writer.putUnsigned(readArgument<uint8_t>(this->data, offset)); break;
+		case UNSIGNED16:	writer.putUnsigned(readArgument<uint16_t>(this->data, offset)); break;
+		case UNSIGNED32:	writer.putUnsigned(readArgument<uint32_t>(this->data, offset)); break;
+		case UNSIGNED64:	writer.putUnsigned(readArgument<uint64_t>(this->data, offset)); break;
+		case BOOL:		writer.put(readArgument<bool>(this->data, offset) ? "true" : "false"); break;
+		case CHAR:		writer.put(readArgument<char>(this->data, offset)); break;
+		case FLOAT:		writer.putFloatingPoint(readArgument<float>(this->data, offset)); break;
+		case DOUBLE:	writer.putFloatingPoint(readArgument<double>(this->data, offset)); break;
+		case POINTER:
+			writer.put("0x");
+			writer.putUnsigned(reinterpret_cast<uintptr_t>(readArgument<const void*>(this->data, offset)), 16);
+			break;
+		default:
+			break;
+		}
+		kinds >>= 4;
+	}
+
+	return writer.finish();
+}
+
+}//Endnamespace SlimExcLib
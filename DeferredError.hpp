@@ -0,0 +1,229 @@
+/*
+ * 	Copyright (C) 2023 Philipp Rimmele & Valentin Felder
+ *
+ *	Redistribution and use in source and binary forms, with or without modification, are
+ *	permitted provided that the following conditions are met:
+ *
+ * 	1. Redistributions of source code must retain the above copyright notice, this list
+ *     of conditions and the following disclaimer.
+ *
+ * 	2. Redistributions in binary form must reproduce the above copyright notice, this
+ *     list of conditions and the following disclaimer in the documentation and/or
+ *     other materials provided with the distribution.
+ *
+ *	3. Neither the name of the copyright holder nor the names of its contributors
+ * 	   may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	“AS IS” AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *	TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *	PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *	HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *	SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *	LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *	DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *	THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *	(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ *	THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EXCEPTIONSYSTEM_DEFERREDERROR_HPP_
+#define EXCEPTIONSYSTEM_DEFERREDERROR_HPP_
+
+/*
+ * This file implements class "DeferredError", a compact exception which fits into the small Exceptionbuffer and is
+ * formatted lazily. It only contains a 32-bit id of its message-template and the packed, trivially-copyable arguments.
+ * The id is computed at compile-time (hash of the template-text and the argument-types), the template-text itself is
+ * registered in the linker-section "slimexc_messages". The text is only looked up and formatted by "format()",
+ * so throwing costs no more than throwing an integer. An offline tool can also decode the ids with this section.
+ *
+ * Example:
+ *   uint32_t recordId; uint16_t length;	//6 bytes of arguments, which fit into the default buffer size
+ *   throw SLIM_EXC_DEFERRED_ERROR("record {} has invalid length {}", recordId, length);
+ *   ...
+ *   catch(DeferredError& error) { char text[128]; error.format(text, sizeof(text)); }
+ *
+ * Placeholders "{}" are replaced by the arguments in order. Supported argument-types are integers, bool, char,
+ * float and double (6 decimals, exponent-notation from 2^64 on), enums and pointers (printed as address).
+ * The total size of all arguments has to fit into the Exceptionbuffer minus 4 bytes for the id (6 bytes with the
+ * default buffer size of 10).
+ * Requires GCC (statement-expressions) and a GNU-compatible assembler and linker.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "ExceptionState.hpp"
+
+namespace SlimExcLib
+{
+
+// One entry of the linker-section. Written by the assembler, so the layout must not contain any padding.
+struct MessageRecord
+{
+	const char* text;
+	uintptr_t argumentKinds;	// 4 bits per argument (see DeferredError::Kind), first argument in the lowest bits
+	uint32_t id;
+	uint32_t reserved;
+};
+
+static_assert(sizeof(MessageRecord) == 2 * sizeof(void*) + 8, "MessageRecord must not contain padding");
+
+class DeferredError final
+{
+public:
+	static const size_t idSize = 4;
+	static const size_t maxArgumentSize = ExceptionState::exceptionBufferSize - idSize;
+	static const size_t maxArgumentCount = 8;
+
+	enum Kind : uint8_t {
+		END = 0,
+		SIGNED8, SIGNED16, SIGNED32, SIGNED64,
+		UNSIGNED8, UNSIGNED16, UNSIGNED32, UNSIGNED64,
+		BOOL, CHAR, FLOAT, DOUBLE, POINTER
+	};
+
+	// Helper-type to transport the argument-kinds through "decltype()" (see SLIM_EXC_DEFERRED_ERROR)
+	template <uintptr_t K> struct ArgumentKinds
+	{
+		static constexpr uintptr_t value = K;
+	};
+
+private:
+	unsigned char data[ExceptionState::exceptionBufferSize];	// id followed by the packed arguments
+
+	template <class A> struct Normalized
+	{
+		typedef typename std::decay<A>::type decayed;
+		typedef typename std::conditional<std::is_enum<decayed>::value, std::underlying_type<decayed>, std::decay<decayed>>::type::type valueType;
+		typedef typename std::conditional<std::is_pointer<valueType>::value, const void*, valueType>::type type;
+	};
+
+	template <class A> static constexpr Kind getKind() noexcept
+	{
+		typedef typename Normalized<A>::type type;
+
+		if constexpr(std::is_same<type, bool>::value)
+		{
+			return BOOL;
+		}
+		else if constexpr(std::is_same<type, char>::value)
+		{
+			return CHAR;
+		}
+		else if constexpr(std::is_same<type, float>::value)
+		{
+			return FLOAT;
+		}
+		else if constexpr(std::is_same<type, double>::value)
+		{
+			return DOUBLE;
+		}
+		else if constexpr(std::is_same<type, const void*>::value)
+		{
+			return POINTER;
+		}
+		else
+		{
+			static_assert(std::is_integral<type>::value && (sizeof(type) <= 8), "Unsupported argument-type for DeferredError");
+			constexpr uint8_t sizeIndex = (sizeof(type) == 1) ? 0 : (sizeof(type) == 2) ? 1 : (sizeof(type) == 4) ? 2 : 3;
+			return static_cast<Kind>((std::is_signed<type>::value ? SIGNED8 : UNSIGNED8) + sizeIndex);
+		}
+	}
+
+	template <class... A> static constexpr uintptr_t packKinds() noexcept
+	{
+		uintptr_t kinds = 0;
+		uint8_t shift = 0;
+		((kinds |= static_cast<uintptr_t>(getKind<A>()) << shift, shift += 4), ...);
+		return kinds;
+	}
+
+	template <class A> inline void packArgument(size_t& offset, const A& argument) noexcept
+	{
+		typename Normalized<A>::type value = static_cast<typename Normalized<A>::type>(argument);
+		const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+		for (size_t i = 0; i < sizeof(value); i++)
+		{
+			this->data[offset++] = bytes[i];
+		}
+	}
+
+public:
+	// Use SLIM_EXC_DEFERRED_ERROR instead, which computes the id and registers the message-template.
+	template <class... A> inline DeferredError(uint32_t id, const A&... arguments) noexcept
+	{
+		static_assert(sizeof...(A) <= maxArgumentCount, "DeferredError supports at most 8 arguments");
+		static_assert((0 + ... + sizeof(typename Normalized<A>::type)) <= maxArgumentSize, "The arguments of DeferredError do not fit into the Exceptionbuffer");
+
+		for (size_t i = 0; i < sizeof(this->data); i++)
+		{
+			this->data[i] = (i < idSize) ? static_cast<unsigned char>(id >> (8 * i)) : 0;
+		}
+		__attribute__((unused)) size_t offset = idSize;
+		(packArgument(offset, arguments), ...);
+	}
+
+	// Only declared, used in "decltype()" to get the argument-kinds of the given expressions
+	template <class... A> static ArgumentKinds<packKinds<A...>()> argumentKindsOf(const A&...) noexcept;
+
+	// Computes the id of a message-template (FNV-1a of the text and the argument-kinds)
+	static constexpr uint32_t makeId(const char* text, uintptr_t argumentKinds) noexcept
+	{
+		uint32_t hash = 2166136261u;
+		for (; *text != '\0'; text++)
+		{
+			hash = (hash ^ static_cast<unsigned char>(*text)) * 16777619u;
+		}
+		for (size_t i = 0; i < maxArgumentCount; i++)
+		{
+			hash = (hash ^ static_cast<unsigned char>((argumentKinds >> (4 * i)) & 0xF)) * 16777619u;
+		}
+		return hash;
+	}
+
+	inline uint32_t getId() const noexcept
+	{
+		uint32_t id = 0;
+		for (size_t i = 0; i < idSize; i++)
+		{
+			id |= static_cast<uint32_t>(this->data[i]) << (8 * i);
+		}
+		return id;
+	}
+
+	// Returns the registered record of the message-template, or NULL if it is not registered in this binary.
+	const MessageRecord* getRecord() const noexcept;
+
+	// Writes the formatted message (always null-terminated if size > 0) and returns the length of the complete message,
+	// which can be larger than size-1 if it was truncated.
+	size_t format(char* buffer, size_t size) const noexcept;
+};
+
+static_assert(sizeof(DeferredError) <= ExceptionState::exceptionBufferSize, "DeferredError does not fit into the Exceptionbuffer");
+
+}//Endnamespace SlimExcLib
+
+// Emits the record of a message-template into the linker-section. Does not generate any instruction.
+#define __SLIM_EXC_REGISTER_MESSAGE(id, text, argumentKinds) \
+	__asm__ __volatile__( \
+		".pushsection slimexc_messages,\"aw\"\n\t" \
+		".balign %c3\n\t" \
+		".dc.a %c1, %c2\n\t" \
+		".long %c0, 0\n\t" \
+		".popsection" \
+		: \
+		: "i"(id), "i"(text), "i"(argumentKinds), "i"(alignof(SlimExcLib::MessageRecord)))
+
+// Creates a DeferredError from a string-literal with "{}"-placeholders and the arguments.
+#define SLIM_EXC_DEFERRED_ERROR(text, ...) \
+	({ \
+		typedef decltype(SlimExcLib::DeferredError::argumentKindsOf(__VA_ARGS__)) __slimExcKinds; \
+		constexpr uint32_t __slimExcId = SlimExcLib::DeferredError::makeId(text, __slimExcKinds::value); \
+		__SLIM_EXC_REGISTER_MESSAGE(__slimExcId, text, __slimExcKinds::value); \
+		(SlimExcLib::DeferredError(__slimExcId, ##__VA_ARGS__)); \
+	})
+
+#endif /* EXCEPTIONSYSTEM_DEFERREDERROR_HPP_ */
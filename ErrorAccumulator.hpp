@@ -0,0 +1,180 @@
+/*
+ * 	Copyright (C) 2023 Philipp Rimmele & Valentin Felder
+ *
+ *	Redistribution and use in source and binary forms, with or without modification, are
+ *	permitted provided that the following conditions are met:
+ *
+ * 	1. Redistributions of source code must retain the above copyright notice, this list
+ *     of conditions and the following disclaimer.
+ *
+ * 	2. Redistributions in binary form must reproduce the above copyright notice, this
+ *     list of conditions and the following disclaimer in the documentation and/or
+ *     other materials provided with the distribution.
+ *
+ *	3. Neither the name of the copyright holder nor the names of its contributors
+ * 	   may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	“AS IS” AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *	TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *	PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *	HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *	SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *	LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *	DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *	THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *	(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ *	THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EXCEPTIONSYSTEM_ERRORACCUMULATOR_HPP_
+#define EXCEPTIONSYSTEM_ERRORACCUMULATOR_HPP_
+
+/*
+ * This file implements class "ErrorAccumulator", which collects the exceptions of many items of a bulk operation
+ * instead of aborting it. "run()" processes one item in an own ExceptionState-frame: an exception of one of the
+ * types E (or a type derived from them) is moved directly out of the frame into a contiguous arena, without a
+ * catch-cycle. The failures can be iterated afterwards. Item index, type index, typeId and destructor are stored
+ * in separate arrays (struct-of-arrays), so filtering by type only touches the small arrays.
+ *
+ * Example:
+ *   static ErrorAccumulator<1024, ParseError, RangeError> errors;
+ *   for(size_t i = 0; i < count; i++) { errors.run(i, &ingest, records[i]); }
+ *   for(size_t i = 0; i < errors.size(); i++) { if(errors.holdsErrorOfTypeT<RangeError>(i)) { ... } }
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ExceptionState.hpp"
+
+namespace SlimExcLib
+{
+
+template <size_t Capacity, class... E> class ErrorAccumulator final
+{
+	static_assert(Capacity > 0, "ErrorAccumulator needs a capacity");
+	static_assert(sizeof...(E) > 0, "ErrorAccumulator needs at least one exception type");
+	static_assert(sizeof...(E) < UINT8_MAX, "ErrorAccumulator supports at most 254 exception types");
+
+private:
+	// One row of the arena, padded to the alignment of the Exceptionbuffer, so every row is aligned
+	struct alignas(ExceptionState::exceptionBufferAlignment) Buffer
+	{
+		unsigned char bytes[ExceptionState::exceptionBufferSize];
+	};
+
+	Buffer buffers[Capacity];
+	size_t items[Capacity];			// Index of the failed item, as passed to "run()"
+	uint8_t typeIndices[Capacity];	// Index of the matching type in E
+#ifndef __SLIM_EXC_ONLY_ONE_TYPE
+	ExceptionState::TypeId typeIds[Capacity];
+#ifndef __SLIM_EXC_ONLY_FUNDAMENTAL_TYPES
+	ExceptionState::Destructor destructs[Capacity];
+#endif //__SLIM_EXC_ONLY_FUNDAMENTAL_TYPES
+#endif //__SLIM_EXC_ONLY_ONE_TYPE
+
+	size_t count = 0;
+	size_t droppedCount = 0;	// Failures which did not fit into the arena anymore
+
+	// Moves the exception contained in "holder" into the arena.
+	inline void store(ExceptionState& holder, uint8_t typeIndex, size_t item) noexcept
+	{
+		if(this->count >= Capacity)
+		{
+			this->droppedCount++;	//The exception stays in "holder" and is destructed with the frame
+			return;
+		}
+
+		size_t i = this->count;
+		this->items[i] = item;
+		this->typeIndices[i] = typeIndex;
+#ifndef __SLIM_EXC_ONLY_ONE_TYPE
+		this->typeIds[i] = holder.typeId;
+#ifndef __SLIM_EXC_ONLY_FUNDAMENTAL_TYPES
+		this->destructs[i] = holder.destruct;
+#endif //__SLIM_EXC_ONLY_FUNDAMENTAL_TYPES
+#endif //__SLIM_EXC_ONLY_ONE_TYPE
+		holder.moveBufferTo(this->buffers[i].bytes);	//The arena is the owner now
+		this->count++;
+	}
+
+public:
+	ErrorAccumulator() noexcept = default;
+	ErrorAccumulator(const ErrorAccumulator&) = delete;
+	ErrorAccumulator& operator=(const ErrorAccumulator&) = delete;
+
+	inline ~ErrorAccumulator() noexcept
+	{
+		this->clear();
+	}
+
+	// Processes one item by calling "function" in an own ExceptionState-frame. Returns false if it failed: an exception of one of
+	// the types E is taken out of the frame and recorded (see "ExceptionState::takeThrownInstance()"), others propagate to the caller.
+	template <class F, class... Args> bool run(size_t item, F&& function, Args&&... args)
+	{
+		ExceptionState frame(ExceptionState::getCurrentExceptionState());
+
+		function(static_cast<Args&&>(args)...);
+
+		if(!frame.isExceptionThrowing())
+		{
+			return true;
+		}
+
+		frame.takeThrownInstance<E...>([this, item](ExceptionState& holder, uint8_t typeIndex) noexcept {
+			this->store(holder, typeIndex, item);
+		});
+		return false;
+	}
+
+	// Number of recorded failures
+	inline size_t size() noexcept { return this->count; }
+
+	// Number of failures, which were handled but not recorded because the arena was full
+	inline size_t getDroppedCount() noexcept { return this->droppedCount; }
+
+	// Index of the item of the failure with the given index
+	inline size_t getItem(size_t index) noexcept { return this->items[index]; }
+
+	// Index of the first type in E which matched the failure with the given index
+	inline uint8_t getTypeIndex(size_t index) noexcept { return this->typeIndices[index]; }
+
+	// Checks if the given template parameter type is equal to OR a basetype of the failure with the given index.
+	template <class X> inline bool holdsErrorOfTypeT(size_t index) noexcept
+	{
+#ifdef __SLIM_EXC_ONLY_ONE_TYPE
+		(void)index;
+		return true;
+#else
+		return ExceptionState::isTypeIdCatchableAsT<X>(this->typeIds[index], this->buffers[index].bytes);
+#endif
+	}
+
+	// Returns a reference to the failure with the given index. Should only be called after the type was checked with "holdsErrorOfTypeT()".
+	template <class X> inline void* getErrorReference(size_t index) noexcept
+	{
+		return ExceptionState::getReferenceFromBuffer<X>(this->buffers[index].bytes);
+	}
+
+	// Destructs all recorded failures.
+	void clear() noexcept
+	{
+#if (not defined __SLIM_EXC_ONLY_FUNDAMENTAL_TYPES) && (not defined __SLIM_EXC_ONLY_ONE_TYPE)
+		for (size_t i = 0; i < this->count; i++)
+		{
+			if(this->destructs[i] != nullptr)
+			{
+				this->destructs[i]((const void*)this->buffers[i].bytes);
+			}
+		}
+#endif
+		this->count = 0;
+		this->droppedCount = 0;
+	}
+};
+
+}//Endnamespace SlimExcLib
+
+#endif /* EXCEPTIONSYSTEM_ERRORACCUMULATOR_HPP_ */
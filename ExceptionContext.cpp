@@ -0,0 +1,78 @@
+/*
+ * 	Copyright (C) 2023 Philipp Rimmele & Valentin Felder
+ *
+ *	Redistribution and use in source and binary forms, with or without modification, are
+ *	permitted provided that the following conditions are met:
+ *
+ * 	1. Redistributions of source code must retain the above copyright notice, this list
+ *     of conditions and the following disclaimer.
+ *
+ * 	2. Redistributions in binary form must reproduce the above copyright notice, this
+ *     list of conditions and the following disclaimer in the documentation and/or
+ *     other materials provided with the distribution.
+ *
+ *	3. Neither the name of the copyright holder nor the names of its contributors
+ * 	   may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	“AS IS” AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *	TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *	PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *	HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *	SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *	LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *	DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *	THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *	(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ *	THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <new>	//placement-new, freestanding
+
+#include "ExceptionContext.hpp"
+
+namespace SlimExcLib
+{
+
+/*
+ * Async-signal-safety: a handler can interrupt enter()/leave() only on the same execution context, so it always runs to completion
+ * before the interrupted code continues. Therefore it is sufficient to prevent the compiler from reordering the accesses to the
+ * chain (signal-fences), no atomic read-modify-write is required.
+ */
+
+void ExceptionContext::enter() noexcept
+{
+	if(this->active)
+	{
+		std::terminate();	//The context is already in use, e.g. a handler interrupted itself
+	}
+	this->active = true;
+	__atomic_signal_fence(__ATOMIC_SEQ_CST);
+
+	this->interruptedES = ExceptionState::getCurrentExceptionState();
+	__atomic_signal_fence(__ATOMIC_SEQ_CST);
+
+	//The root has no previous ExceptionState, so nothing can propagate into the interrupted chain. Sets the current ExceptionState.
+#ifdef __SLIM_EXC_THREAD_REGISTRY
+	new(this->rootBuffer) ExceptionState(NULL, NULL);	//Not published, the interrupted thread could be writing its snapshot
+#else
+	new(this->rootBuffer) ExceptionState(NULL);
+#endif
+	__atomic_signal_fence(__ATOMIC_SEQ_CST);
+}
+
+void ExceptionContext::leave() noexcept
+{
+	//Terminates on an unhandled exception, otherwise destructs a handled one.
+	reinterpret_cast<ExceptionState*>(this->rootBuffer)->~ExceptionState();
+	__atomic_signal_fence(__ATOMIC_SEQ_CST);
+
+	ExceptionState::setCurrentExceptionState(this->interruptedES);
+	__atomic_signal_fence(__ATOMIC_SEQ_CST);
+
+	this->interruptedES = NULL;
+	this->active = false;
+}
+
+}//Endnamespace SlimExcLib
@@ -0,0 +1,98 @@
+/*
+ * 	Copyright (C) 2023 Philipp Rimmele & Valentin Felder
+ *
+ *	Redistribution and use in source and binary forms, with or without modification, are
+ *	permitted provided that the following conditions are met:
+ *
+ * 	1. Redistributions of source code must retain the above copyright notice, this list
+ *     of conditions and the following disclaimer.
+ *
+ * 	2. Redistributions in binary form must reproduce the above copyright notice, this
+ *     list of conditions and the following disclaimer in the documentation and/or
+ *     other materials provided with the distribution.
+ *
+ *	3. Neither the name of the copyright holder nor the names of its contributors
+ * 	   may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	“AS IS” AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *	TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *	PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *	HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *	SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *	LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *	DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *	THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *	(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ *	THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EXCEPTIONSYSTEM_EXCEPTIONCONTEXT_HPP_
+#define EXCEPTIONSYSTEM_EXCEPTIONCONTEXT_HPP_
+
+/*
+ * This file implements class "ExceptionContext", a preallocated root for a separate chain of ExceptionState-Objects.
+ * It is used for asynchronous execution contexts like signal-handlers or interrupt-service-routines, which interrupt
+ * a thread at any point and would otherwise push their frames onto the (possibly half-updated) chain of that thread.
+ * Exceptions inside the context never reach the interrupted chain: an unhandled exception calls std::terminate().
+ *
+ * Entering and leaving is async-signal-safe and lock-free, as long as the user-implemented
+ * "getCurrentExceptionState()" and "setCurrentExceptionState()" are (e.g. initial-exec thread_local or a global variable).
+ * Use one ExceptionContext per handler (and per thread, if the handler can run on multiple threads at the same time).
+ *
+ * Example:
+ *   static ExceptionContext sigContext;
+ *   void onSignal(int sig)
+ *   {
+ *       ExceptionContextScope scope(sigContext);
+ *       ... //code using SlimExc
+ *   }
+ */
+
+#include "ExceptionState.hpp"
+
+namespace SlimExcLib
+{
+
+class ExceptionContext final
+{
+private:
+	alignas(ExceptionState) unsigned char rootBuffer[sizeof(ExceptionState)];	// Storage for the root-ExceptionState
+	ExceptionState* interruptedES = NULL;	// Head of the interrupted chain, restored when leaving the context
+	volatile bool active = false;
+
+public:
+	// Switches the current ExceptionState to the root of this context. Nested entering of the same context calls std::terminate().
+	void enter() noexcept;
+
+	// Switches back to the interrupted chain. An unhandled exception inside the context calls std::terminate().
+	void leave() noexcept;
+
+	inline bool isActive() noexcept { return this->active; }
+};
+
+// Enters an ExceptionContext for the lifetime of the scope.
+class ExceptionContextScope final
+{
+private:
+	ExceptionContext& context;
+
+public:
+	inline ExceptionContextScope(ExceptionContext& context) noexcept : context(context)
+	{
+		this->context.enter();
+	}
+
+	inline ~ExceptionContextScope() noexcept
+	{
+		this->context.leave();
+	}
+
+	ExceptionContextScope(const ExceptionContextScope&) = delete;
+	ExceptionContextScope& operator=(const ExceptionContextScope&) = delete;
+};
+
+}//Endnamespace SlimExcLib
+
+#endif /* EXCEPTIONSYSTEM_EXCEPTIONCONTEXT_HPP_ */
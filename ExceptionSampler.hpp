@@ -0,0 +1,216 @@
+/*
+ * 	Copyright (C) 2023 Philipp Rimmele & Valentin Felder
+ *
+ *	Redistribution and use in source and binary forms, with or without modification, are
+ *	permitted provided that the following conditions are met:
+ *
+ * 	1. Redistributions of source code must retain the above copyright notice, this list
+ *     of conditions and the following disclaimer.
+ *
+ * 	2. Redistributions in binary form must reproduce the above copyright notice, this
+ *     list of conditions and the following disclaimer in the documentation and/or
+ *     other materials provided with the distribution.
+ *
+ *	3. Neither the name of the copyright holder nor the names of its contributors
+ * 	   may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	“AS IS” AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *	TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *	PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *	HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *	SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *	LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *	DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *	THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *	(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ *	THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EXCEPTIONSYSTEM_EXCEPTIONSAMPLER_HPP_
+#define EXCEPTIONSYSTEM_EXCEPTIONSAMPLER_HPP_
+
+/*
+ * This file implements class "ExceptionSampler", a sampling profiler for the time the registered threads spend in
+ * exception handling. Each "sample()" reads the snapshots of all threads in the ThreadRegistry (lock-free, the
+ * threads are never stopped) and counts per thread and per exception type, whether the thread was unwinding
+ * (throwing/rethrowing), handling (inside a catch-block) or neither. Multiplying the counts with the sampling period
+ * gives the estimated time. The workers only pay for publishing their snapshot (see "ThreadRegistry.hpp").
+ *
+ * The sampler does not create a thread, "run()" is meant to be called by a thread of the user. Example:
+ *   static ExceptionSampler<64> sampler;
+ *   static bool stopSampling = false;	//set with "__atomic_store_n(&stopSampling, true, __ATOMIC_RELEASE)"
+ *   void* samplingThread(void*) { sampler.run(&sleepMicroseconds, 1000, stopSampling); return NULL; }
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ExceptionState.hpp"
+
+#ifdef __SLIM_EXC_THREAD_REGISTRY
+
+namespace SlimExcLib
+{
+
+template <size_t MaxTypes> class ExceptionSampler final
+{
+	static_assert(MaxTypes > 0, "ExceptionSampler needs space for at least one type");
+
+public:
+	struct ThreadStatistics
+	{
+		uintptr_t owner;			// Identifier of the thread, 0 if the record was never sampled
+		uint32_t samples;			// Number of samples while the thread was registered
+		uint32_t handlingSamples;
+		uint32_t unwindingSamples;
+		uint32_t maxDepth;			// Deepest ExceptionState-chain seen
+	};
+
+	struct TypeStatistics
+	{
+		const void* typeIdentifier;	// See "ExceptionState::getTypeIdentifier()"
+		uint32_t handlingSamples;
+		uint32_t unwindingSamples;
+	};
+
+private:
+	ThreadStatistics threads[ThreadRegistry::capacity] = {};
+	uint32_t generations[ThreadRegistry::capacity] = {};	// Generation of the sampled record, to detect a new owner
+	TypeStatistics types[MaxTypes] = {};
+	size_t typeCount = 0;
+	uint32_t sampleCount = 0;
+	uint32_t missedCount = 0;		// Snapshots which could not be read consistently
+	uint32_t droppedTypeCount = 0;	// Samples whose type did not fit into "types" anymore
+
+	inline TypeStatistics* findType(const void* typeIdentifier) noexcept
+	{
+		for (size_t i = 0; i < this->typeCount; i++)
+		{
+			if(this->types[i].typeIdentifier == typeIdentifier)
+			{
+				return &this->types[i];
+			}
+		}
+		if(this->typeCount >= MaxTypes)
+		{
+			return NULL;
+		}
+		TypeStatistics* type = &this->types[this->typeCount++];
+		*type = TypeStatistics();
+		type->typeIdentifier = typeIdentifier;
+		return type;
+	}
+
+public:
+	// Takes one sample of all registered threads.
+	void sample() noexcept
+	{
+		this->sampleCount++;
+
+		for (size_t i = 0; i < ThreadRegistry::capacity; i++)
+		{
+			ThreadSnapshot snapshot;
+			uint32_t generation;
+			ThreadRegistry::ReadResult result = ThreadRegistry::readSnapshot(i, snapshot, generation);
+			if(result != ThreadRegistry::VALID)
+			{
+				if(result == ThreadRegistry::BUSY)
+				{
+					this->missedCount++;
+				}
+				continue;
+			}
+
+			ThreadStatistics& thread = this->threads[i];
+			if((generation != this->generations[i]) || (thread.samples == 0))
+			{//The record belongs to a new thread
+				thread = ThreadStatistics();
+				thread.owner = snapshot.owner;
+				this->generations[i] = generation;
+			}
+
+			thread.samples++;
+			if(snapshot.depth > thread.maxDepth)
+			{
+				thread.maxDepth = snapshot.depth;
+			}
+
+			if((snapshot.unwindingFrames == 0) && (snapshot.handlingFrames == 0))
+			{
+				continue;
+			}
+
+			TypeStatistics* type = this->findType(snapshot.typeIdentifier);
+			if(type == NULL)
+			{
+				this->droppedTypeCount++;
+			}
+
+			//Unwinding has priority, e.g. a throw inside a catch-block
+			if(snapshot.unwindingFrames > 0)
+			{
+				thread.unwindingSamples++;
+				if(type != NULL)
+				{
+					type->unwindingSamples++;
+				}
+			}
+			else
+			{
+				thread.handlingSamples++;
+				if(type != NULL)
+				{
+					type->handlingSamples++;
+				}
+			}
+		}
+	}
+
+	// Takes samples every "period" (in the unit of "sleep") until "stop" is set. Another thread has to set it atomically,
+	// e.g. with "__atomic_store_n(&stop, true, __ATOMIC_RELEASE)".
+	void run(void (*sleep)(uint32_t period) noexcept, uint32_t period, const bool& stop) noexcept
+	{
+		while(!__atomic_load_n(&stop, __ATOMIC_ACQUIRE))
+		{
+			this->sample();
+			sleep(period);
+		}
+	}
+
+	inline uint32_t getSampleCount() noexcept { return this->sampleCount; }
+
+	// Number of times a thread was not counted in a sample, because its snapshot changed during all retries
+	inline uint32_t getMissedCount() noexcept { return this->missedCount; }
+	inline uint32_t getDroppedTypeCount() noexcept { return this->droppedTypeCount; }
+
+	// Statistics of the thread registered in the record with the given index (< ThreadRegistry::capacity)
+	inline const ThreadStatistics& getThread(size_t index) noexcept { return this->threads[index]; }
+
+	inline size_t getTypeCount() noexcept { return this->typeCount; }
+	inline const TypeStatistics& getType(size_t index) noexcept { return this->types[index]; }
+
+	void clear() noexcept
+	{
+		for (size_t i = 0; i < ThreadRegistry::capacity; i++)
+		{
+			this->threads[i] = ThreadStatistics();
+			this->generations[i] = 0;
+		}
+		for (size_t i = 0; i < MaxTypes; i++)
+		{
+			this->types[i] = TypeStatistics();
+		}
+		this->typeCount = 0;
+		this->sampleCount = 0;
+		this->missedCount = 0;
+		this->droppedTypeCount = 0;
+	}
+};
+
+}//Endnamespace SlimExcLib
+
+#endif //__SLIM_EXC_THREAD_REGISTRY
+
+#endif /* EXCEPTIONSYSTEM_EXCEPTIONSAMPLER_HPP_ */
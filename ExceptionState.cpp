@@ -35,7 +35,16 @@ using namespace SlimRTTI;
 namespace SlimExcLib
 {
 
+#ifdef __SLIM_EXC_THREAD_REGISTRY
 ExceptionState::ExceptionState(ExceptionState* previous) noexcept :
+		ExceptionState(previous, (previous != NULL) ? previous->threadRecord : getCurrentThreadRecord())
+{
+}
+
+ExceptionState::ExceptionState(ExceptionState* previous, ThreadRecord* record) noexcept :
+#else
+ExceptionState::ExceptionState(ExceptionState* previous) noexcept :
+#endif //__SLIM_EXC_THREAD_REGISTRY
 #ifndef __SLIM_EXC_ONLY_ONE_TYPE
 		typeId(),
 #ifndef __SLIM_EXC_ONLY_FUNDAMENTAL_TYPES
@@ -43,8 +52,24 @@ ExceptionState::ExceptionState(ExceptionState* previous) noexcept :
 #endif //__SLIM_EXC_ONLY_FUNDAMENTAL_TYPES
 #endif //__SLIM_EXC_ONLY_ONE_TYPE
 		previousES(previous)
+#ifdef __SLIM_EXC_THREAD_REGISTRY
+		, threadRecord(record)
+#endif
+#ifdef __SLIM_EXC_BACKTRACE_DEPTH
+		, stackTop((previous != NULL) ? previous->stackTop : this)
+#endif
 {
 	setCurrentExceptionState(this);
+
+#ifdef __SLIM_EXC_THREAD_REGISTRY
+	if(record != NULL)
+	{
+		record->beginWrite();
+		ThreadRecord::store(record->snapshot.head, static_cast<const void*>(this));
+		ThreadRecord::store(record->snapshot.depth, static_cast<uint32_t>(record->snapshot.depth + 1));
+		record->endWrite();
+	}
+#endif
 }
 
 ExceptionState::~ExceptionState() noexcept
@@ -53,10 +78,29 @@ ExceptionState::~ExceptionState() noexcept
 	{
 		this->propagateUp();
 	}
+	else
+	{
 #if (not defined __SLIM_EXC_ONLY_FUNDAMENTAL_TYPES) && (not defined __SLIM_EXC_ONLY_ONE_TYPE)
-	else if (this->destruct != nullptr)
+		if (this->destruct != nullptr)
+		{
+			this->destruct((const void*)&this->exceptionBuffer);
+		}
+#endif
+#ifdef __SLIM_EXC_CAUSE_STACK_DEPTH
+		this->releaseCauses();
+#endif
+	}
+
+#ifdef __SLIM_EXC_THREAD_REGISTRY
+	ThreadRecord* record = this->threadRecord;
+	if(record != NULL)
 	{
-		this->destruct((const void*)&this->exceptionBuffer);
+		this->changeState(State::CLEAR);	//A handled exception ends here
+
+		record->beginWrite();
+		ThreadRecord::store(record->snapshot.head, static_cast<const void*>(this->previousES));
+		ThreadRecord::store(record->snapshot.depth, static_cast<uint32_t>(record->snapshot.depth - 1));
+		record->endWrite();
 	}
 #endif
 
@@ -69,17 +113,36 @@ void ExceptionState::propagateUp() noexcept
 {
 	if((this->previousES == NULL) || this->previousES->isExceptionThrowing())
 	{
+		__SLIM_EXC_TRACE(terminate, this->getTypeIdentifier(), this, this->state, this->state);
 		std::terminate();
 	}
 
 	//If the exception to rethrow is in the previous "exceptionState"-Instance
 	if (this->isExceptionInState(State::RETHROW) && (this->previousES->isExceptionInState(State::HANDLETHROW)))
 	{
+		__SLIM_EXC_TRACE(propagate, this->previousES->getTypeIdentifier(), this->previousES, this->previousES->state, State::THROW);
 		//Set it to throwing (it holds the exception)
 		this->previousES->setToThrowingState();
 		return;
 	}
 
+	__SLIM_EXC_TRACE(propagate, this->getTypeIdentifier(), this->previousES, this->previousES->state, this->state);
+
+#ifdef __SLIM_EXC_CAUSE_STACK_DEPTH
+	if(this->previousES->isExceptionInState(State::HANDLETHROW))
+	{//Thrown out of the handler: keep the handled exception as cause of the new one, below the causes it already has
+		uint8_t newCauseBase = this->previousES->pushCause((this->causeBase != noCauses) ? this->causeBase : getCurrentCauseStack()->top);
+		if(newCauseBase < this->causeBase)
+		{
+			this->causeBase = newCauseBase;
+		}
+	}
+	else
+	{
+		this->previousES->releaseCauses();
+	}
+#endif
+
 #if (not  defined __SLIM_EXC_ONLY_FUNDAMENTAL_TYPES) && (not defined __SLIM_EXC_ONLY_ONE_TYPE)
 	//Destruct previous exception if one exists there
 	if (this->previousES->destruct != nullptr)
@@ -93,6 +156,8 @@ void ExceptionState::propagateUp() noexcept
 
 void ExceptionState::takeInstance(ExceptionState* source) noexcept
 {
+	__SLIM_EXC_TRACE(take_instance, source->getTypeIdentifier(), this, this->state, source->state);
+
 #ifndef __SLIM_EXC_ONLY_ONE_TYPE
 	this->typeId = source->typeId;
 
@@ -101,7 +166,20 @@ void ExceptionState::takeInstance(ExceptionState* source) noexcept
 #endif//__SLIM_EXC_ONLY_FUNDAMENTAL_TYPES
 #endif//__SLIM_EXC_ONLY_ONE_TYPE
 
-	this->state = source->state;
+	this->changeState(source->state);
+
+#ifdef __SLIM_EXC_CAUSE_STACK_DEPTH
+	this->causeBase = source->causeBase;
+	source->causeBase = noCauses;
+#endif
+
+#ifdef __SLIM_EXC_BACKTRACE_DEPTH
+	for (uint8_t i = 0; i < source->backtraceSize; i++)
+	{
+		this->backtrace[i] = source->backtrace[i];
+	}
+	this->backtraceSize = source->backtraceSize;
+#endif
 
 	for (size_t i = 0; i < sizeof(this->exceptionBuffer); i++)
 	{
@@ -119,7 +197,182 @@ void ExceptionState::takeInstance(ExceptionState* source) noexcept
 	source->typeId = nullptr;
 #endif //__SLIM_EXC_RTTI_STRATEGY_SLIM
 #endif //__SLIM_EXC_ONLY_ONE_TYPE
-	source->state = State::CLEAR;
+	source->changeState(State::CLEAR);
+}
+
+void ExceptionState::moveInstanceTo(Instance& target) noexcept
+{
+#ifndef __SLIM_EXC_ONLY_ONE_TYPE
+	target.typeId = this->typeId;
+#ifndef __SLIM_EXC_ONLY_FUNDAMENTAL_TYPES
+	target.destruct = this->destruct;
+#endif //__SLIM_EXC_ONLY_FUNDAMENTAL_TYPES
+#endif //__SLIM_EXC_ONLY_ONE_TYPE
+	this->moveBufferTo(target.exceptionBuffer);
+}
+
+void ExceptionState::throwInstance(Instance& source) noexcept
+{
+	if (this->isExceptionThrowing())
+	{
+		__SLIM_EXC_TRACE(terminate, this->getTypeIdentifier(), this, this->state, this->state);
+		std::terminate(); //multiple exceptions cannot coexist!
+	}
+
+	this->releaseForNewException();
+
+	for (size_t i = 0; i < sizeof(this->exceptionBuffer); i++)
+	{
+		this->exceptionBuffer[i] = source.exceptionBuffer[i];
+	}
+
+#ifndef __SLIM_EXC_ONLY_ONE_TYPE
+	this->typeId = source.typeId;
+#ifndef __SLIM_EXC_ONLY_FUNDAMENTAL_TYPES
+	this->destruct = source.destruct;
+	source.destruct = nullptr;
+#endif //__SLIM_EXC_ONLY_FUNDAMENTAL_TYPES
+#endif //__SLIM_EXC_ONLY_ONE_TYPE
+
+#ifdef __SLIM_EXC_BACKTRACE_DEPTH
+	this->captureBacktrace(1);	//Skip this function
+#endif
+
+	__SLIM_EXC_TRACE(throw_exception, this->getTypeIdentifier(), this, this->state, State::THROW);
+	this->changeState(State::THROW);
+}
+
+#ifdef __SLIM_EXC_BACKTRACE_DEPTH
+void ExceptionState::captureBacktrace(uint8_t skippedFrames) noexcept
+{
+	//The own frame-record is always valid, all others are only read if they lie between it and the root ExceptionState-Object.
+	//So a caller without frame-pointer (e.g. a library-callback) only ends the backtrace, it cannot cause a fault.
+	void* const* frame = reinterpret_cast<void* const*>(__builtin_frame_address(0));
+	uintptr_t top = reinterpret_cast<uintptr_t>(this->stackTop);
+	uint8_t count = 0;
+
+	while(count < __SLIM_EXC_BACKTRACE_DEPTH)
+	{
+		if(skippedFrames > 0)
+		{
+			skippedFrames--;
+		}
+		else
+		{
+			this->backtrace[count++] = frame[1];
+		}
+
+		//The stack grows downwards: the frame-record of the caller has to be above, aligned and below the root.
+		void* const* next = reinterpret_cast<void* const*>(frame[0]);
+		if((next <= frame) || ((reinterpret_cast<uintptr_t>(next) % sizeof(void*)) != 0)
+				|| ((reinterpret_cast<uintptr_t>(next) + 2 * sizeof(void*)) > top))
+		{
+			break;
+		}
+		frame = next;
+	}
+	this->backtraceSize = count;
+}
+#endif //__SLIM_EXC_BACKTRACE_DEPTH
+
+#ifdef __SLIM_EXC_CAUSE_STACK_DEPTH
+uint8_t ExceptionState::pushCause(uint8_t position) noexcept
+{
+	CauseStack* stack = getCurrentCauseStack();
+
+	//The new exception inherits all causes of the contained exception
+	uint8_t newCauseBase = (this->causeBase < position) ? this->causeBase : position;
+
+	if(stack->top < __SLIM_EXC_CAUSE_STACK_DEPTH)
+	{
+		//Reserve the entry before writing it, so an interrupting signal-handler cannot use it (see ExceptionContext)
+		uint8_t index = stack->top;
+		stack->top++;
+		__atomic_signal_fence(__ATOMIC_SEQ_CST);
+
+		//Causes above "position" are more recent, they stay in front of the new entry
+		for(; index > position; index--)
+		{
+			stack->entries[index] = stack->entries[index - 1];
+		}
+		this->moveInstanceTo(stack->entries[position]);	//The CauseStack is the owner now
+	}
+#if (not defined __SLIM_EXC_ONLY_FUNDAMENTAL_TYPES) && (not defined __SLIM_EXC_ONLY_ONE_TYPE)
+	else if (this->destruct != nullptr)
+	{//CauseStack is full: the cause gets lost
+		this->destruct((const void*)&this->exceptionBuffer);
+		this->destruct = nullptr;
+	}
+#endif
+
+	this->causeBase = noCauses;
+	return newCauseBase;
+}
+
+void ExceptionState::releaseCauses() noexcept
+{
+	if(this->causeBase == noCauses)
+	{
+		return;
+	}
+
+	CauseStack* stack = getCurrentCauseStack();
+	while(stack->top > this->causeBase)
+	{
+#if (not defined __SLIM_EXC_ONLY_FUNDAMENTAL_TYPES) && (not defined __SLIM_EXC_ONLY_ONE_TYPE)
+		Instance& entry = stack->entries[stack->top - 1];
+		if(entry.destruct != nullptr)
+		{
+			entry.destruct((const void*)&entry.exceptionBuffer);
+		}
+#endif
+		//Free the entry after destructing it, so an interrupting signal-handler cannot use it (see ExceptionContext)
+		__atomic_signal_fence(__ATOMIC_SEQ_CST);
+		stack->top--;
+	}
+	this->causeBase = noCauses;
+}
+#endif //__SLIM_EXC_CAUSE_STACK_DEPTH
+
+#ifdef __SLIM_EXC_THREAD_REGISTRY
+void ExceptionState::publishStateChange(State oldState) noexcept
+{
+	//Only "CLEAR -> handling/unwinding" and similar changes of the category have to be published
+	int8_t handlingChange = ((this->state == State::HANDLETHROW) || (this->state == State::HANDLERETHROW))
+			- ((oldState == State::HANDLETHROW) || (oldState == State::HANDLERETHROW));
+	int8_t unwindingChange = (this->state >= State::THROW) - (oldState >= State::THROW);
+	if((handlingChange == 0) && (unwindingChange == 0))
+	{
+		return;
+	}
+
+	ThreadRecord* record = this->threadRecord;
+	uint32_t handlingFrames = record->snapshot.handlingFrames + handlingChange;
+	uint32_t unwindingFrames = record->snapshot.unwindingFrames + unwindingChange;
+
+	//The type of the innermost active exception: the one of this ExceptionState-Object, or when it got cleared, of the next active one.
+	ExceptionState* active = this;
+	if(this->state == State::CLEAR)
+	{
+		active = NULL;
+		if((handlingFrames + unwindingFrames) > 0)
+		{
+			active = const_cast<ExceptionState*>(static_cast<const ExceptionState*>(record->snapshot.head));
+			while((active != NULL) && (active->state == State::CLEAR))
+			{
+				active = active->previousES;
+			}
+		}
+	}
+	ExceptionState* holding = (active != NULL) ? active->getHoldingExceptionState() : NULL;
+	const void* typeIdentifier = (holding != NULL) ? holding->getTypeIdentifier() : NULL;
+
+	record->beginWrite();
+	ThreadRecord::store(record->snapshot.handlingFrames, handlingFrames);
+	ThreadRecord::store(record->snapshot.unwindingFrames, unwindingFrames);
+	ThreadRecord::store(record->snapshot.typeIdentifier, typeIdentifier);
+	record->endWrite();
 }
+#endif //__SLIM_EXC_THREAD_REGISTRY
 
 }
@@ -40,6 +40,15 @@
 #include <cstddef>
 
 #include "SlimRTTI.hpp"
+#include "ExceptionTrace.hpp"
+
+#ifdef __SLIM_EXC_THROWN_TYPE_REGISTRY
+#include "ThrownTypeRegistry.hpp"
+#endif
+
+#ifdef __SLIM_EXC_THREAD_REGISTRY
+#include "ThreadRegistry.hpp"
+#endif
 
 #ifdef __GXX_RTTI
 #include <typeinfo>
@@ -56,6 +65,13 @@
 #define __SLIM_EXC_BUFFER_SIZE 10
 #endif
 
+//The throw-path is always inlined when backtraces are captured, so the backtrace starts at the throw-site
+#ifdef __SLIM_EXC_BACKTRACE_DEPTH
+#define __SLIM_EXC_THROW_INLINE __attribute__((always_inline)) inline
+#else
+#define __SLIM_EXC_THROW_INLINE inline
+#endif
+
 //use this in your code if the config is set to "onlyOneType"
 typedef __SLIM_EXC_THROWABLETYPE throwable_t;
 
@@ -81,43 +97,106 @@ template<typename T> constexpr std::remove_reference_t<T>&& move(T&& t) noexcept
 }
 
 
+template <class T, class... E> class Result;
+template <size_t Capacity, class... E> class ErrorAccumulator;
+class ExceptionContext;
 
 // This class represents the entire state of the current exception, including the Exception object itself.
 class ExceptionState final {
+	template <class T, class... E> friend class Result;
+	template <size_t Capacity, class... E> friend class ErrorAccumulator;
+	friend class ExceptionContext;
+
 public:
 	//Version of the GCC-Exception-Library
 	static const uint8_t versionMajor = 0;	//Checked by plugin to be compatible
 	static const uint8_t versionMinor = 9;	//Checked by plugin to be compatible
 	static const uint8_t versionPatch = 0;	//Not checked
 
-private:
-
+	//Size and alignment of the internal Exceptionbuffer
 #ifndef __SLIM_EXC_ONLY_ONE_TYPE
-	// The raw buffer for the Exception object.
-	unsigned char exceptionBuffer[__SLIM_EXC_BUFFER_SIZE] alignas(alignof(std::max_align_t));
+	static constexpr size_t exceptionBufferSize = __SLIM_EXC_BUFFER_SIZE;
+	static constexpr size_t exceptionBufferAlignment = alignof(std::max_align_t);
 #else
-	unsigned char exceptionBuffer[sizeof(__SLIM_EXC_THROWABLETYPE)] alignas(alignof(__SLIM_EXC_THROWABLETYPE));
+	static constexpr size_t exceptionBufferSize = sizeof(__SLIM_EXC_THROWABLETYPE);
+	static constexpr size_t exceptionBufferAlignment = alignof(__SLIM_EXC_THROWABLETYPE);
 #endif
 
 #ifndef __SLIM_EXC_ONLY_ONE_TYPE
-//When class-instances can be thrown, we need a complex typeId
 #ifdef __SLIM_EXC_RTTI_STRATEGY_SLIM
-//typeId with SlimRTTI
-	InstanceType typeId;
+	typedef InstanceType TypeId;				//typeId with SlimRTTI
 #else
-//typeId with normal RTTI
-	const std::type_info* typeId;
+	typedef const std::type_info* TypeId;		//typeId with normal RTTI
 #endif
+#ifndef __SLIM_EXC_ONLY_FUNDAMENTAL_TYPES
+	typedef void(*Destructor)(const void*) noexcept;
+#endif //__SLIM_EXC_ONLY_FUNDAMENTAL_TYPES
+#endif //__SLIM_EXC_ONLY_ONE_TYPE
+
+	// Storage for an Exception object outside of an ExceptionState-Object. It is moved in and out by copying the raw buffer.
+	struct Instance {
+		alignas(exceptionBufferAlignment) unsigned char exceptionBuffer[exceptionBufferSize];
+#ifndef __SLIM_EXC_ONLY_ONE_TYPE
+		TypeId typeId;
+#ifndef __SLIM_EXC_ONLY_FUNDAMENTAL_TYPES
+		Destructor destruct = nullptr;
+#endif //__SLIM_EXC_ONLY_FUNDAMENTAL_TYPES
+#endif //__SLIM_EXC_ONLY_ONE_TYPE
+	};
+
+#ifdef __SLIM_EXC_CAUSE_STACK_DEPTH
+	static_assert(__SLIM_EXC_CAUSE_STACK_DEPTH < UINT8_MAX, "The depth of the CauseStack has to be smaller than 255");
+
+	// Preallocated stack for the causes of exceptions. When a new exception is thrown inside a handler, the handled
+	// exception is moved onto this stack instead of being destructed, so the new exception can inspect its causes.
+	// One instance per thread has to be provided by the user, see "getCurrentCauseStack()".
+	class CauseStack final {
+		friend class ExceptionState;
+
+		Instance entries[__SLIM_EXC_CAUSE_STACK_DEPTH];
+
+		uint8_t top = 0;	// Index of the next free entry
+
+	public:
+		// Number of causes on the stack (of all exceptions of the thread)
+		inline uint8_t getSize() const noexcept { return this->top; }
+	};
+#endif //__SLIM_EXC_CAUSE_STACK_DEPTH
+
+private:
+
+	// The raw buffer for the Exception object.
+	unsigned char exceptionBuffer[exceptionBufferSize] alignas(exceptionBufferAlignment);
+
+#ifndef __SLIM_EXC_ONLY_ONE_TYPE
+//When class-instances can be thrown, we need a complex typeId
+	TypeId typeId;
 
 #ifndef __SLIM_EXC_ONLY_FUNDAMENTAL_TYPES
 //The destructor ist only needed when class-instances can be thrown
-	void(*destruct)(const void*) noexcept; // A pointer to the Destructor of the currently active Exception, if it isn't a fundamental type.
+	Destructor destruct; // A pointer to the Destructor of the currently active Exception, if it isn't a fundamental type.
 #endif //__SLIM_EXC_ONLY_FUNDAMENTAL_TYPES
 #endif //__SLIM_EXC_ONLY_ONE_TYPE
 
 
 	ExceptionState* previousES = NULL;
 
+#ifdef __SLIM_EXC_THREAD_REGISTRY
+	ThreadRecord* threadRecord;	// Record of the thread the chain is published to, NULL if not published
+#endif
+
+#ifdef __SLIM_EXC_BACKTRACE_DEPTH
+	static_assert(__SLIM_EXC_BACKTRACE_DEPTH <= UINT8_MAX, "The depth of the backtrace has to be smaller than 256");
+	const void* backtrace[__SLIM_EXC_BACKTRACE_DEPTH];	// Return-addresses at the throw-site of the contained exception (most recent first)
+	uint8_t backtraceSize = 0;
+	const void* stackTop;	// Address of the root ExceptionState-Object, the frame-pointer walk never reads at or above it
+#endif
+
+#ifdef __SLIM_EXC_CAUSE_STACK_DEPTH
+	static const uint8_t noCauses = UINT8_MAX;
+	uint8_t causeBase = noCauses;	// Index of the first cause of the contained exception in the CauseStack, or "noCauses"
+#endif
+
 	enum State : uint8_t {
 		CLEAR = 0,				//empty (no active exceptions exists in this ExceptionState-Object)
 		HANDLERETHROW = 1,		//handling the exception contained in an ExceptionState-Object lower down the list
@@ -126,6 +205,29 @@ private:
 		RETHROW = 4				//rethrowing the exception contained in an ExceptionState-Object lower down the list
 	} state = CLEAR;
 
+#ifdef __SLIM_EXC_THREAD_REGISTRY
+	// Constructor with the record to publish to, used for the root of an ExceptionContext (no record).
+	ExceptionState(ExceptionState* previous, ThreadRecord* record) noexcept;
+
+	// Publishes the snapshot of the thread after the state of this ExceptionState-Object changed from "oldState".
+	void publishStateChange(State oldState) noexcept;
+#endif
+
+	// Every change of the state has to use this function, so the snapshot of the thread stays up to date.
+	inline void changeState(State newState) noexcept
+	{
+#ifdef __SLIM_EXC_THREAD_REGISTRY
+		State oldState = this->state;
+		this->state = newState;
+		if(this->threadRecord != NULL)
+		{
+			this->publishStateChange(oldState);
+		}
+#else
+		this->state = newState;
+#endif
+	}
+
 	//Helper-Fuction to comare adresses with lvalue
 	template <class T> static inline bool compareAdresses(T& exception, void* bufferAdr) noexcept
 	{
@@ -142,6 +244,54 @@ private:
 
 	void takeInstance(ExceptionState* source) noexcept;
 
+	// Moves the contained exception into "target", this ExceptionState-Object is not the owner anymore (see "ownsInstance()").
+	void moveInstanceTo(Instance& target) noexcept;
+
+	// Like "moveInstanceTo()" for targets with own storage of the typeId and the destructor, which have to be taken before.
+	inline void moveBufferTo(unsigned char* buffer) noexcept
+	{
+		for (size_t i = 0; i < sizeof(this->exceptionBuffer); i++)
+		{
+			buffer[i] = this->exceptionBuffer[i];
+		}
+
+#ifndef __SLIM_EXC_ONLY_ONE_TYPE
+#ifdef __SLIM_EXC_RTTI_STRATEGY_SLIM
+		this->typeId.clear();	//Not catchable anymore, see "ownsInstance()"
+#else
+		this->typeId = nullptr;
+#endif
+#ifndef __SLIM_EXC_ONLY_FUNDAMENTAL_TYPES
+		this->destruct = nullptr;
+#endif //__SLIM_EXC_ONLY_FUNDAMENTAL_TYPES
+#endif //__SLIM_EXC_ONLY_ONE_TYPE
+	}
+
+	// Checks if the Exception object is still contained, false after it was moved out with "moveInstanceTo()".
+	// With only one type the exception is trivially copyable, so moving out leaves a valid copy.
+	inline bool ownsInstance() noexcept
+	{
+#if (defined __SLIM_EXC_ONLY_ONE_TYPE)
+		return true;
+#elif (defined __SLIM_EXC_RTTI_STRATEGY_SLIM)
+		return !this->typeId.isEqualTo<void>();
+#else
+		return this->typeId != nullptr;
+#endif
+	}
+
+	// Throws the exception contained in "source", which is moved into this ExceptionState-Object.
+	void throwInstance(Instance& source) noexcept;
+
+#ifdef __SLIM_EXC_CAUSE_STACK_DEPTH
+	// Moves the contained exception onto the CauseStack at "position", the entries above are shifted up.
+	// Returns the index of the first cause for the new exception.
+	uint8_t pushCause(uint8_t position) noexcept;
+
+	// Destructs all causes of the contained exception.
+	void releaseCauses() noexcept;
+#endif
+
 	inline ExceptionState* getLatestHandlingExceptionState(void)noexcept
 	{
 		ExceptionState* tmpState = this->previousES;
@@ -156,29 +306,168 @@ private:
 		return NULL;
 	}
 
-	template <class T> bool throwExceptionHelper(T& exc) noexcept
+	// Returns the ExceptionState-Object which contains the currently active Exception (NULL if there is none).
+	inline ExceptionState* getHoldingExceptionState(void) noexcept
+	{
+		if((this->state == State::RETHROW) || (this->state == State::HANDLERETHROW))
+		{
+			return getLatestHandlingExceptionState();
+		}
+		return this;
+	}
+
+	// Returns an identifier for the type of the contained exception (used for tracing)
+	inline const void* getTypeIdentifier() noexcept
+	{
+#if (defined __SLIM_EXC_ONLY_ONE_TYPE)
+		return NULL;
+#elif (defined __SLIM_EXC_RTTI_STRATEGY_SLIM)
+		return this->typeId.getId();
+#else
+		return this->typeId;
+#endif
+	}
+
+#ifndef __SLIM_EXC_ONLY_ONE_TYPE
+	// Checks if the given template parameter type is equal to OR a basetype of the Exception object described by "typeId".
+	template <class T> static inline bool isTypeIdCatchableAsT(TypeId& typeId, void* buffer) noexcept
+	{
+#if (defined __SLIM_EXC_RTTI_STRATEGY_SLIM)
+		(void)buffer;
+		return typeId.do_catch<T>();
+#else
+#if (defined __SLIM_EXC_PLUGIN) || (defined __SLIM_EXC_FOREIGN_BOUNDARY)	//Only to prevent compiler-error if SlimExceptions are disabled
+		return (typeId != nullptr) && typeid(T).__do_catch(typeId, (void**)buffer, SlimRTTI::getPointerLevel<T>());
+#else
+		(void)typeId;
+		(void)buffer;
+		return false;	//Only to prevent compiler-Warning
+#endif//__SLIM_EXC_PLUGIN
+#endif //__SLIM_EXC_RTTI_STRATEGY_SLIM
+	}
+#endif //__SLIM_EXC_ONLY_ONE_TYPE
+
+	static const uint8_t noCatchingType = UINT8_MAX;
+
+	// Returns the index of the first template parameter type, which is equal to OR a basetype of the contained Exception, or "noCatchingType".
+	template <class First, class... Rest> inline uint8_t findCatchingType(uint8_t index = 0) noexcept
+	{
+#ifdef __SLIM_EXC_ONLY_ONE_TYPE
+		return index;
+#else
+		if(isTypeIdCatchableAsT<First>(this->typeId, this->exceptionBuffer))
+		{
+			return index;
+		}
+
+		if constexpr(sizeof...(Rest) > 0)
+		{
+			return findCatchingType<Rest...>(index + 1);
+		}
+		else
+		{
+			return noCatchingType;
+		}
+#endif
+	}
+
+	// Takes the exception thrown into this frame out of it without a catch, if one of the types E catches it: "take(*this, typeIndex)"
+	// moves it (or leaves it in the frame to be destructed) and the frame is marked as handled. Otherwise the exception propagates
+	// when the frame is destructed, also a rethrow of an exception which is still used by the handler of an outer frame.
+	// Returns the index of the catching type in E, or "noCatchingType".
+	template <class... E, class Take> inline uint8_t takeThrownInstance(Take&& take) noexcept
+	{
+		if(!this->isExceptionInState(State::THROW))
+		{
+			return noCatchingType;
+		}
+
+		uint8_t typeIndex = this->findCatchingType<E...>();
+		if(typeIndex != noCatchingType)
+		{
+			take(*this, typeIndex);
+			this->setToHandlingState();	//The exception does not propagate out of this frame
+		}
+		return typeIndex;
+	}
+
+	// Returns a reference to the Exception object of type T stored in "buffer".
+	template <class T> static inline void* getReferenceFromBuffer(unsigned char* buffer) noexcept
 	{
+		if constexpr(std::is_pointer<T>::value)
+		{
+			return (void*)(*reinterpret_cast<void**>(buffer));
+		}
+		else
+		{
+			return reinterpret_cast<void*>(buffer);
+		}
+	}
+
+#ifdef __SLIM_EXC_BACKTRACE_DEPTH
+	// Captures the return-addresses of the calling functions by walking the frame-pointers, the first one is the throw-site
+	// (after skipping "skippedFrames" library-functions). Never inlined, so it always has an own frame-record. Requires
+	// "-fno-omit-frame-pointer" and the common frame-record layout {previous frame-pointer, return-address} (e.g. x86, x86-64, AArch64).
+	__attribute__((noinline)) void captureBacktrace(uint8_t skippedFrames) noexcept;
+#endif //__SLIM_EXC_BACKTRACE_DEPTH
+
+	// Releases the contained exception before a new one is thrown: it is kept as cause or destructed.
+	inline void releaseForNewException() noexcept
+	{
+#ifdef __SLIM_EXC_CAUSE_STACK_DEPTH
+		uint8_t newCauseBase;
+		if(this->state == State::HANDLETHROW)
+		{//Thrown inside the handler: keep the handled exception as cause of the new one
+			newCauseBase = this->pushCause(getCurrentCauseStack()->top);
+		}
+		else
+		{
+			this->releaseCauses();
+			newCauseBase = getCurrentCauseStack()->top;
+		}
+#endif //__SLIM_EXC_CAUSE_STACK_DEPTH
+
+#if (not defined __SLIM_EXC_ONLY_FUNDAMENTAL_TYPES) && (not defined __SLIM_EXC_ONLY_ONE_TYPE)
+		if(this->destruct != nullptr)
+		{//Call destructor for the old object
+			this->destruct((const void*)&this->exceptionBuffer);
+			this->destruct = nullptr;
+		}
+#endif
+
+#ifdef __SLIM_EXC_CAUSE_STACK_DEPTH
+		this->causeBase = newCauseBase;
+#endif
+	}
+
+	template <class T> __SLIM_EXC_THROW_INLINE bool throwExceptionHelper(T& exc) noexcept
+	{
+#ifdef __SLIM_EXC_THROWN_TYPE_REGISTRY
+		registerThrownType<T>();
+#endif
  		if (this->isExceptionThrowing())
 		{
+			__SLIM_EXC_TRACE(terminate, this->getTypeIdentifier(), this, this->state, this->state);
 			std::terminate(); //multiple exceptions cannot coexist! This could happen when a unhandled throw occurs (nested) inside a catch-block, or within an Exception-object's Destructor/Move-Constructor.
 		}
 		else
 		{
 			if(compareAdresses(exc, this->exceptionBuffer)) //Explicite rethrow?
 			{
+				if(!this->ownsInstance())
+				{
+					__SLIM_EXC_TRACE(terminate, NULL, this, this->state, this->state);
+					std::terminate();	//The exception was moved out of the handler (e.g. into a Result)
+				}
+				__SLIM_EXC_TRACE(rethrow, this->getTypeIdentifier(), this, this->state, State::THROW);
 				this->setToThrowingState();
 				return false;
 			}
 
+			this->releaseForNewException();
+
 #ifndef __SLIM_EXC_ONLY_ONE_TYPE
 #ifndef __SLIM_EXC_ONLY_FUNDAMENTAL_TYPES
-			if(this->destruct != nullptr)
-			{//Call destructor for the old object
-				this->destruct((const void*)&this->exceptionBuffer);
-			}
-
-
-
 			if constexpr(std::is_destructible<T>()) //is T destructible?
 			{
 				destruct = &ExceptionState::destructorInvoker<T>;
@@ -191,12 +480,16 @@ private:
 #ifdef __SLIM_EXC_RTTI_STRATEGY_SLIM
 			this->typeId.set<T>();
 #else
-#ifdef __SLIM_EXC_PLUGIN	//Only to prevent compiler-error if SlimExceptions are disabled
+#if (defined __SLIM_EXC_PLUGIN) || (defined __SLIM_EXC_FOREIGN_BOUNDARY)	//Only to prevent compiler-error if SlimExceptions are disabled
 			this->typeId = &typeid(T);
 #endif//__SLIM_EXC_PLUGIN
 #endif //__SLIM_EXC_RTTI_STRATEGY_SLIM
 #endif //__SLIM_EXC_ONLY_ONE_TYPE
-			this->state = State::THROW;
+#ifdef __SLIM_EXC_BACKTRACE_DEPTH
+			this->captureBacktrace(0);
+#endif
+			__SLIM_EXC_TRACE(throw_exception, this->getTypeIdentifier(), this, this->state, State::THROW);
+			this->changeState(State::THROW);
 		}
  		return true;
 	}
@@ -214,17 +507,34 @@ public:
 
 	static void setCurrentExceptionState(ExceptionState* newInstance) noexcept;
 
+#ifdef __SLIM_EXC_CAUSE_STACK_DEPTH
+	// Returns a pointer to the CauseStack of the current thread. Has to be implemented by the user, like "getCurrentExceptionState()".
+	static CauseStack* getCurrentCauseStack() noexcept;
+#endif
+
+#ifdef __SLIM_EXC_THREAD_REGISTRY
+	// Returns the record of the current thread (see "ThreadRegistry::acquire()"), or NULL if it should not be published.
+	// Has to be implemented by the user, like "getCurrentExceptionState()". Only called for the root of the chain.
+	static ThreadRecord* getCurrentThreadRecord() noexcept;
+#endif
+
 	inline bool isExceptionInState(State state) noexcept { return this->state == state; }
 	inline bool isExceptionThrowing() noexcept { return this->state >= State::THROW; }
-	inline void setToHandlingState() noexcept { this->state = State::HANDLETHROW; }
-	inline void setToThrowingState() noexcept { this->state = State::THROW; }
-	inline void setToHandleRethrowState() noexcept { this->state = State::HANDLERETHROW; }
-	inline void setToRethrowingState() noexcept { this->state = State::RETHROW; }
+	inline void setToHandlingState() noexcept { this->changeState(State::HANDLETHROW); }
+	inline void setToThrowingState() noexcept { this->changeState(State::THROW); }
+	inline void setToHandleRethrowState() noexcept { this->changeState(State::HANDLERETHROW); }
+	inline void setToRethrowingState() noexcept { this->changeState(State::RETHROW); }
 
 	inline void rethrow(void) noexcept
 	{
 		if(this->state == State::HANDLETHROW)
 		{
+			if(!this->ownsInstance())
+			{
+				__SLIM_EXC_TRACE(terminate, NULL, this, this->state, this->state);
+				std::terminate();	//The exception was moved out of the handler (e.g. into a Result)
+			}
+			__SLIM_EXC_TRACE(rethrow, this->getTypeIdentifier(), this, this->state, State::THROW);
 			this->setToThrowingState();
 			return;
 		}
@@ -235,12 +545,19 @@ public:
 		{
 			if(tmpState->state == State::HANDLETHROW)
 			{
+				if(!tmpState->ownsInstance())
+				{
+					__SLIM_EXC_TRACE(terminate, NULL, this, this->state, this->state);
+					std::terminate();	//The exception was moved out of the handler (e.g. into a Result)
+				}
+				__SLIM_EXC_TRACE(rethrow, tmpState->getTypeIdentifier(), this, this->state, State::RETHROW);
 				this->setToRethrowingState();
 				return;
 			}
 			tmpState = tmpState->previousES;
 		}
 
+		__SLIM_EXC_TRACE(terminate, NULL, this, this->state, this->state);
 		std::terminate();
 	}
 
@@ -258,15 +575,7 @@ public:
 		{
 			tmpState = getLatestHandlingExceptionState();
 		}
-#if (defined __SLIM_EXC_RTTI_STRATEGY_SLIM)
-		return tmpState->typeId.do_catch<T>();
-#else
-#ifdef __SLIM_EXC_PLUGIN	//Only to prevent compiler-error if SlimExceptions are disabled
-		return typeid(T).__do_catch(tmpState->typeId, (void**)&this->exceptionBuffer, SlimRTTI::getPointerLevel<T>());
-#else
-		return false;	//Only to prevent compiler-Warning
-#endif//__SLIM_EXC_PLUGIN
-#endif //__SLIM_EXC_RTTI_STRATEGY_SLIM
+		return isTypeIdCatchableAsT<T>(tmpState->typeId, this->exceptionBuffer);
 #endif //__SLIM_EXC_ONLY_ONE_TYPE
 	}
 
@@ -280,24 +589,88 @@ public:
 		{
 			//Search in the older exceptions for the correct reference
 			tmpState = getLatestHandlingExceptionState();
+			__SLIM_EXC_TRACE(catch_exception, tmpState->getTypeIdentifier(), this, this->state, State::HANDLERETHROW);
 			this->setToHandleRethrowState();
 		}
 		else
 		{
+			__SLIM_EXC_TRACE(catch_exception, this->getTypeIdentifier(), this, this->state, State::HANDLETHROW);
 			this->setToHandlingState();
 		}
 
-		if constexpr(std::is_pointer<T>::value)
+		return getReferenceFromBuffer<T>(tmpState->exceptionBuffer);
+	}
+
+#ifdef __SLIM_EXC_BACKTRACE_DEPTH
+	// Returns the number of return-addresses captured when the currently active Exception was thrown and sets "frames" to them (most recent first).
+	// The backtrace ends at the function which created the root ExceptionState-Object, which therefore has to be a local variable.
+	// Inside an ExceptionContext (root not on the stack) only the throw-site is captured.
+	// The addresses can be symbolized offline, e.g. with "addr2line -f -C -e <binary>" (subtract the load-address for position-independent binaries).
+	inline size_t getBacktrace(const void* const*& frames) noexcept
+	{
+		ExceptionState* tmpState = getHoldingExceptionState();
+		if(tmpState == NULL)
 		{
-			return (void*)(*reinterpret_cast<void**>(tmpState->exceptionBuffer));
+			frames = NULL;
+			return 0;
 		}
-		else
+		frames = tmpState->backtrace;
+		return tmpState->backtraceSize;
+	}
+#endif //__SLIM_EXC_BACKTRACE_DEPTH
+
+#ifdef __SLIM_EXC_CAUSE_STACK_DEPTH
+	// Returns the number of causes of the currently active Exception.
+	inline size_t getCauseCount() noexcept
+	{
+		ExceptionState* tmpState = getHoldingExceptionState();
+
+		if((tmpState == NULL) || (tmpState->causeBase == noCauses))
+		{
+			return 0;
+		}
+		return getCurrentCauseStack()->top - tmpState->causeBase;
+	}
+
+	// Checks if the given template parameter type is equal to OR a basetype of the cause with the given index.
+	// Index 0 is the direct cause, followed by its own causes and then by the exceptions of the enclosing handlers.
+	template <class T> inline bool causeHoldsExceptionOfTypeT(size_t index) noexcept
+	{
+		if(index >= getCauseCount())
 		{
-			return reinterpret_cast<void*>(tmpState->exceptionBuffer);
+			return false;
 		}
+#ifdef __SLIM_EXC_ONLY_ONE_TYPE
+		return true;
+#else
+		Instance& entry = getCurrentCauseStack()->entries[getCurrentCauseStack()->top - 1 - index];
+		return isTypeIdCatchableAsT<T>(entry.typeId, entry.exceptionBuffer);
+#endif
+	}
+
+	// Returns a reference to the cause with the given index. Should only be called after the type was successfully checked with "causeHoldsExceptionOfTypeT()".
+	template <class T> inline void* getCauseReference(size_t index) noexcept
+	{
+		CauseStack* stack = getCurrentCauseStack();
+		return getReferenceFromBuffer<T>(stack->entries[stack->top - 1 - index].exceptionBuffer);
+	}
+
+	// Returns a reference to the cause of type T with the lowest index, or NULL if no such cause exists.
+	template <class T> inline void* findCause() noexcept
+	{
+		size_t count = getCauseCount();
+		for(size_t i = 0; i < count; i++)
+		{
+			if(causeHoldsExceptionOfTypeT<T>(i))
+			{
+				return getCauseReference<T>(i);
+			}
+		}
+		return NULL;
 	}
+#endif //__SLIM_EXC_CAUSE_STACK_DEPTH
 
-	template <class T> inline void throwException(T& exc) noexcept
+	template <class T> __SLIM_EXC_THROW_INLINE void throwException(T& exc) noexcept
 	{
 		if(throwExceptionHelper<T>(exc))
 		{
@@ -307,7 +680,7 @@ public:
 	}
 
 	// Throws the Exception which was preconstructed via placement-new into the internal ExceptionBuffer. Use together with "getExceptionBuffer()" and placement-new!
-	template <class T> inline void throwException(T&& exc) noexcept
+	template <class T> __SLIM_EXC_THROW_INLINE void throwException(T&& exc) noexcept
 	{
 		if(throwExceptionHelper<T>(exc))
 		{
@@ -0,0 +1,58 @@
+/*
+ * 	Copyright (C) 2023 Philipp Rimmele & Valentin Felder
+ *
+ *	Redistribution and use in source and binary forms, with or without modification, are
+ *	permitted provided that the following conditions are met:
+ *
+ * 	1. Redistributions of source code must retain the above copyright notice, this list
+ *     of conditions and the following disclaimer.
+ *
+ * 	2. Redistributions in binary form must reproduce the above copyright notice, this
+ *     list of conditions and the following disclaimer in the documentation and/or
+ *     other materials provided with the distribution.
+ *
+ *	3. Neither the name of the copyright holder nor the names of its contributors
+ * 	   may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	“AS IS” AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *	TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *	PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *	HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *	SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *	LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *	DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *	THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *	(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ *	THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EXCEPTIONSYSTEM_EXCEPTIONTRACE_HPP_
+#define EXCEPTIONSYSTEM_EXCEPTIONTRACE_HPP_
+
+/*
+ * Static tracepoints (USDT) for the state transitions of "ExceptionState". They can be attached to a running
+ * process with perf, bpftrace or SystemTap, e.g. "bpftrace -e 'usdt:./app:slimexc:throw_exception { @[arg0] = count(); }'".
+ *
+ * Provider "slimexc", probes: throw_exception, rethrow, propagate, take_instance, catch_exception, terminate
+ * Arguments:  arg0 = typeId of the exception (address of the SlimRTTI-id or of the std::type_info, NULL in mode "Single")
+ *             arg1 = address of the ExceptionState-Object
+ *             arg2 = state before the transition
+ *             arg3 = state after the transition
+ *
+ * Enable them by defining __SLIM_EXC_USDT, which requires <sys/sdt.h> (systemtap-sdt-dev). Without an attached tracer
+ * every probe is a nop-instruction, but its arguments (e.g. "getTypeIdentifier()") are still evaluated into registers
+ * or memory, which also limits the optimization of the surrounding code. See "bench/ExceptionTraceBench.cpp".
+ */
+
+#ifdef __SLIM_EXC_USDT
+#include <sys/sdt.h>
+
+#define __SLIM_EXC_TRACE(probe, typeId, frame, oldState, newState) \
+	DTRACE_PROBE4(slimexc, probe, (const void*)(typeId), (const void*)(frame), (uint8_t)(oldState), (uint8_t)(newState))
+#else
+#define __SLIM_EXC_TRACE(probe, typeId, frame, oldState, newState)
+#endif //__SLIM_EXC_USDT
+
+#endif /* EXCEPTIONSYSTEM_EXCEPTIONTRACE_HPP_ */
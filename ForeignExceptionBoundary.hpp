@@ -0,0 +1,217 @@
+/*
+ * 	Copyright (C) 2023 Philipp Rimmele & Valentin Felder
+ *
+ *	Redistribution and use in source and binary forms, with or without modification, are
+ *	permitted provided that the following conditions are met:
+ *
+ * 	1. Redistributions of source code must retain the above copyright notice, this list
+ *     of conditions and the following disclaimer.
+ *
+ * 	2. Redistributions in binary form must reproduce the above copyright notice, this
+ *     list of conditions and the following disclaimer in the documentation and/or
+ *     other materials provided with the distribution.
+ *
+ *	3. Neither the name of the copyright holder nor the names of its contributors
+ * 	   may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	“AS IS” AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *	TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *	PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *	HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *	SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *	LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *	DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *	THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *	(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ *	THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EXCEPTIONSYSTEM_FOREIGNEXCEPTIONBOUNDARY_HPP_
+#define EXCEPTIONSYSTEM_FOREIGNEXCEPTIONBOUNDARY_HPP_
+
+/*
+ * This file implements class "ForeignExceptionBoundary", an adapter between native C++ exceptions (e.g. thrown by
+ * third-party libraries) and SlimExc. Each "ExceptionMapping" registers a pair of a native and a SlimExc exception type.
+ * - "callNative()" calls native code and converts a native exception into a SlimExc-throw of the mapped type.
+ *   The native try-block is table-based, so the path without exception has no overhead.
+ * - "callSlimExc()" calls SlimExc code and converts a SlimExc exception into a native throw of the mapped type.
+ *   This requires one ExceptionState-frame per call.
+ * Exceptions without mapping cannot cross the boundary and call std::terminate().
+ * For "callNative()" the native types have to be derived from std::exception: the active exception is rethrown once and
+ * the mappings are checked in their order with dynamic_cast, so RTTI is required.
+ *
+ * The adapter has to be used in files which are compiled WITHOUT the SlimExc-plugin (see "Filters/IgnoreFile")
+ * and with native exceptions enabled. All defines of the plugin-configuration (__SLIM_EXC_BUFFER_SIZE, ...) have
+ * to be set to the same values as for the SlimExc-code, otherwise the layout of "ExceptionState" does not match.
+ *
+ * Example:
+ *   typedef ForeignExceptionBoundary<ExceptionMapping<std::bad_alloc, OutOfMemory>,
+ *                                    ExceptionMapping<std::runtime_error, LibraryError>> Boundary;
+ *   int parse(const char* text) { return Boundary::callNative(&thirdparty::parse, text); }
+ */
+
+#ifndef __cpp_exceptions
+#error "ForeignExceptionBoundary.hpp requires native exceptions, compile this file without the SlimExc-plugin!"
+#endif
+
+#if (defined EXCEPTIONSYSTEM_EXCEPTIONSTATE_H_) && (not defined __SLIM_EXC_FOREIGN_BOUNDARY)
+#error "ForeignExceptionBoundary.hpp has to be included before ExceptionState.hpp!"
+#endif
+
+#define __SLIM_EXC_FOREIGN_BOUNDARY
+
+#include <exception>
+#include <type_traits>
+
+#include "ExceptionState.hpp"
+
+namespace SlimExcLib
+{
+
+// Maps the native exception type "Native" to the SlimExc exception type "Slim".
+// By default "Slim" is constructed from "const Native&" (for "callNative()") and "Native" from "const Slim&" (for "callSlimExc()").
+// Other conversions can be implemented by a custom mapping, which provides the same typedefs and functions.
+// "toSlim()" is called in a noexcept context: a native exception thrown by the conversion calls std::terminate().
+template <class Native, class Slim> struct ExceptionMapping
+{
+	typedef Native NativeType;
+	typedef Slim SlimType;
+
+	static inline SlimType toSlim(const NativeType& exc)
+	{
+		return SlimType(exc);
+	}
+
+	static inline NativeType toNative(const SlimType& exc)
+	{
+		return NativeType(exc);
+	}
+};
+
+template <class... Mappings> class ForeignExceptionBoundary final
+{
+	static_assert(sizeof...(Mappings) > 0, "ForeignExceptionBoundary needs at least one ExceptionMapping");
+
+private:
+	// Throws the SlimExc exception of the first mapping whose native type matches "exc". Returns false if there is no such mapping.
+	template <class Mapping, class... Rest> static bool throwAsSlimExc(const std::exception& exc) noexcept
+	{
+		typedef typename Mapping::NativeType NativeType;
+		static_assert(std::is_base_of<std::exception, NativeType>::value,
+				"ForeignExceptionBoundary::callNative() requires native types derived from std::exception");
+
+		if(const NativeType* native = dynamic_cast<const NativeType*>(&exc))
+		{
+			ExceptionState::getCurrentExceptionState()->throwException(Mapping::toSlim(*native));
+			return true;
+		}
+
+		if constexpr(sizeof...(Rest) > 0)
+		{
+			return throwAsSlimExc<Rest...>(exc);
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	// Has to be called inside a native catch-block. Rethrows the active native exception once and throws the mapped SlimExc exception.
+	static void throwActiveAsSlimExc() noexcept
+	{
+		try
+		{
+			throw;
+		}
+		catch (const std::exception& exc)
+		{
+			if(throwAsSlimExc<Mappings...>(exc))
+			{
+				return;
+			}
+		}
+		catch (...)
+		{
+		}
+		std::terminate(); //No mapping for this native exception
+	}
+
+	// Throws the native exception mapped to the SlimExc exception contained in "frame".
+	template <class Mapping, class... Rest> static void throwAsNative(ExceptionState& frame)
+	{
+		typedef typename Mapping::SlimType SlimType;
+
+		if(frame.holdsExceptionOfTypeT<SlimType>())
+		{
+			//Handle the SlimExc exception, it gets destructed by "frame" during the native stack-unwinding
+			const SlimType& exc = *reinterpret_cast<SlimType*>(frame.getExceptionReference<SlimType>());
+			throw Mapping::toNative(exc);
+		}
+
+		if constexpr(sizeof...(Rest) > 0)
+		{
+			throwAsNative<Rest...>(frame);
+		}
+		else
+		{
+			std::terminate(); //No mapping for this SlimExc exception
+		}
+	}
+
+public:
+	// Calls native code. A native exception is thrown as mapped SlimExc exception in the current ExceptionState.
+	// Not noexcept, so the calling SlimExc-code checks for an exception. Non-void return types have to be default-constructible,
+	// because a value has to be returned together with the SlimExc exception.
+	template <class F, class... Args> static auto callNative(F&& function, Args&&... args) -> decltype(function(static_cast<Args&&>(args)...))
+	{
+		typedef decltype(function(static_cast<Args&&>(args)...)) ReturnType;
+		static_assert(std::is_void<ReturnType>::value || std::is_default_constructible<ReturnType>::value,
+				"ForeignExceptionBoundary::callNative() requires a void or default-constructible return type");
+
+		try
+		{
+			return function(static_cast<Args&&>(args)...);
+		}
+		catch (...)
+		{
+			throwActiveAsSlimExc();
+		}
+
+		if constexpr(!std::is_void<ReturnType>::value)
+		{
+			return ReturnType();
+		}
+	}
+
+	// Calls SlimExc-code. A SlimExc exception is thrown as mapped native exception.
+	template <class F, class... Args> static auto callSlimExc(F&& function, Args&&... args) -> decltype(function(static_cast<Args&&>(args)...))
+	{
+		typedef decltype(function(static_cast<Args&&>(args)...)) ReturnType;
+
+		ExceptionState frame(ExceptionState::getCurrentExceptionState());
+
+		if constexpr(std::is_void<ReturnType>::value)
+		{
+			function(static_cast<Args&&>(args)...);
+			if(frame.isExceptionThrowing())
+			{
+				throwAsNative<Mappings...>(frame);
+			}
+		}
+		else
+		{
+			ReturnType result = function(static_cast<Args&&>(args)...);
+			if(frame.isExceptionThrowing())
+			{
+				throwAsNative<Mappings...>(frame);
+			}
+			return result;
+		}
+	}
+};
+
+}//Endnamespace SlimExcLib
+
+#endif /* EXCEPTIONSYSTEM_FOREIGNEXCEPTIONBOUNDARY_HPP_ */
@@ -0,0 +1,222 @@
+/*
+ * 	Copyright (C) 2023 Philipp Rimmele & Valentin Felder
+ *
+ *	Redistribution and use in source and binary forms, with or without modification, are
+ *	permitted provided that the following conditions are met:
+ *
+ * 	1. Redistributions of source code must retain the above copyright notice, this list
+ *     of conditions and the following disclaimer.
+ *
+ * 	2. Redistributions in binary form must reproduce the above copyright notice, this
+ *     list of conditions and the following disclaimer in the documentation and/or
+ *     other materials provided with the distribution.
+ *
+ *	3. Neither the name of the copyright holder nor the names of its contributors
+ * 	   may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	“AS IS” AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *	TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *	PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *	HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *	SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *	LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *	DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *	THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *	(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ *	THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EXCEPTIONSYSTEM_RESULT_HPP_
+#define EXCEPTIONSYSTEM_RESULT_HPP_
+
+/*
+ * This file implements class "Result", which holds either a value of type T or an exception of one of the types E
+ * (or a type derived from them). It is the bridge between SlimExc and value-based error handling ("expected"-style):
+ * - "invoke()" calls a function and takes a thrown exception directly out of the ExceptionState, without a catch.
+ * - "fromActiveException()" takes the exception which is currently handled in a catch-block. The catch-block must not use
+ *   the exception afterwards, a rethrow ("throw;") of it calls std::terminate().
+ * - "raise()" throws the contained exception again.
+ * The exception is moved in and out by copying the raw Exceptionbuffer, like it is done during the propagation,
+ * so neither a copy- nor a move-constructor of the exception is called. Causes of the exception are not kept.
+ */
+
+#include <cstdint>
+#include <type_traits>
+
+#include "ExceptionState.hpp"
+
+namespace SlimExcLib
+{
+
+template <class T, class... E> class Result final
+{
+	static_assert(sizeof...(E) > 0, "Result needs at least one exception type");
+	static_assert(sizeof...(E) < UINT8_MAX - 1, "Result supports at most 253 exception types");
+	static_assert(!std::is_void<T>::value && !std::is_reference<T>::value, "Result needs an object type as value");
+
+private:
+	static const uint8_t valueTag = 0;			// holds a value
+	static const uint8_t emptyTag = UINT8_MAX;	// holds neither a value nor an exception (after "raise()" or a move)
+
+	union {
+		T value;
+		ExceptionState::Instance error;
+	};
+	uint8_t tag;	// valueTag, emptyTag or the index of the matching exception type in E + 1
+
+	inline Result() noexcept : tag(emptyTag)
+	{
+	}
+
+	// Returns the tag for the first type in E which catches the exception contained in "holder", or "emptyTag".
+	static inline uint8_t findErrorTag(ExceptionState* holder) noexcept
+	{
+		uint8_t index = holder->findCatchingType<E...>();
+		if(index == ExceptionState::noCatchingType)
+		{
+			return emptyTag;
+		}
+		return index + 1;
+	}
+
+	inline void destroy() noexcept
+	{
+		if(this->tag == valueTag)
+		{
+			this->value.~T();
+		}
+#if (not defined __SLIM_EXC_ONLY_FUNDAMENTAL_TYPES) && (not defined __SLIM_EXC_ONLY_ONE_TYPE)
+		else if((this->tag != emptyTag) && (this->error.destruct != nullptr))
+		{
+			this->error.destruct((const void*)&this->error.exceptionBuffer);
+		}
+#endif
+		this->tag = emptyTag;
+	}
+
+public:
+	inline Result(const T& value) : value(value), tag(valueTag)
+	{
+	}
+
+	inline Result(T&& value) : value(SlimExcLib::move(value)), tag(valueTag)
+	{
+	}
+
+	inline Result(Result&& other) : tag(other.tag)
+	{
+		if(this->tag == valueTag)
+		{
+			new(&this->value) T(SlimExcLib::move(other.value));
+		}
+		else if(this->tag != emptyTag)
+		{
+			new(&this->error) ExceptionState::Instance(other.error);
+#if (not defined __SLIM_EXC_ONLY_FUNDAMENTAL_TYPES) && (not defined __SLIM_EXC_ONLY_ONE_TYPE)
+			other.error.destruct = nullptr;
+#endif
+			other.tag = emptyTag;
+		}
+	}
+
+	Result(const Result&) = delete;
+	Result& operator=(const Result&) = delete;
+	Result& operator=(Result&&) = delete;
+
+	inline ~Result() noexcept
+	{
+		this->destroy();
+	}
+
+	// Calls "function" in an own ExceptionState-frame and returns its value, or an exception of one of the types E which is
+	// taken out of the frame (see "ExceptionState::takeThrownInstance()"). Other exceptions propagate to the calling SlimExc-code.
+	template <class F, class... Args> static Result invoke(F&& function, Args&&... args)
+	{
+		Result result;
+		ExceptionState frame(ExceptionState::getCurrentExceptionState());
+
+		auto&& returned = function(static_cast<Args&&>(args)...);
+
+		if(!frame.isExceptionThrowing())
+		{
+			new(&result.value) T(static_cast<decltype(returned)&&>(returned));
+			result.tag = valueTag;
+			return result;
+		}
+
+		frame.takeThrownInstance<E...>([&result](ExceptionState& holder, uint8_t typeIndex) noexcept {
+			new(&result.error) ExceptionState::Instance();
+			holder.moveInstanceTo(result.error);
+			result.tag = typeIndex + 1;
+		});
+		return result;
+	}
+
+	// Takes the exception which is currently handled (directly inside the catch-block). It has to match one of the types E.
+	static Result fromActiveException() noexcept
+	{
+		Result result;
+		ExceptionState* holder = ExceptionState::getCurrentExceptionState();
+		if(!holder->isExceptionInState(ExceptionState::State::HANDLETHROW))
+		{
+			std::terminate(); //No active exception, or it is rethrown and still used by an outer handler
+		}
+
+		uint8_t errorTag = findErrorTag(holder);
+		if(errorTag == emptyTag)
+		{
+			std::terminate(); //The active exception does not match any of the types E
+		}
+
+		new(&result.error) ExceptionState::Instance();
+		holder->moveInstanceTo(result.error);
+		result.tag = errorTag;
+		return result;
+	}
+
+	inline bool hasValue() noexcept { return this->tag == valueTag; }
+	inline bool hasError() noexcept { return (this->tag != valueTag) && (this->tag != emptyTag); }
+
+	// Should only be called after "hasValue()" was checked.
+	inline T& getValue() noexcept { return this->value; }
+
+	// Returns the index of the first type in E, which matched the contained exception. Should only be called after "hasError()" was checked.
+	inline size_t getErrorIndex() noexcept { return this->tag - 1; }
+
+	// Checks if the given template parameter type is equal to OR a basetype of the contained exception.
+	template <class X> inline bool holdsErrorOfTypeT() noexcept
+	{
+		if(!this->hasError())
+		{
+			return false;
+		}
+#ifdef __SLIM_EXC_ONLY_ONE_TYPE
+		return true;
+#else
+		return ExceptionState::isTypeIdCatchableAsT<X>(this->error.typeId, this->error.exceptionBuffer);
+#endif
+	}
+
+	// Returns a reference to the contained exception of type X. Should only be called after the type was checked with "holdsErrorOfTypeT()".
+	template <class X> inline void* getErrorReference() noexcept
+	{
+		return ExceptionState::getReferenceFromBuffer<X>(this->error.exceptionBuffer);
+	}
+
+	// Throws the contained exception in the current ExceptionState, without calling any constructor.
+	// Does nothing if the Result holds a value. Not noexcept, so the calling SlimExc-code checks for an exception.
+	__SLIM_EXC_THROW_INLINE void raise()
+	{
+		if(this->hasError())
+		{
+			ExceptionState::getCurrentExceptionState()->throwInstance(this->error);
+			this->tag = emptyTag;
+		}
+	}
+};
+
+}//Endnamespace SlimExcLib
+
+#endif /* EXCEPTIONSYSTEM_RESULT_HPP_ */
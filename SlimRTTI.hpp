@@ -326,6 +326,11 @@ template<typename T> inline void** getTypeId() noexcept
 			return *this;
 		}
 
+		inline void** getId() const noexcept
+		{
+			return this->typeId;
+		}
+
 		template <class T> void set() noexcept
 		{
 			this->typeId = getTypeId<T>();
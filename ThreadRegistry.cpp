@@ -0,0 +1,117 @@
+/*
+ * 	Copyright (C) 2023 Philipp Rimmele & Valentin Felder
+ *
+ *	Redistribution and use in source and binary forms, with or without modification, are
+ *	permitted provided that the following conditions are met:
+ *
+ * 	1. Redistributions of source code must retain the above copyright notice, this list
+ *     of conditions and the following disclaimer.
+ *
+ * 	2. Redistributions in binary form must reproduce the above copyright notice, this
+ *     list of conditions and the following disclaimer in the documentation and/or
+ *     other materials provided with the distribution.
+ *
+ *	3. Neither the name of the copyright holder nor the names of its contributors
+ * 	   may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	“AS IS” AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *	TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *	PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *	HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *	SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *	LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *	DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *	THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *	(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ *	THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "ExceptionState.hpp"
+
+#ifdef __SLIM_EXC_THREAD_REGISTRY
+
+namespace SlimExcLib
+{
+
+ThreadRecord ThreadRegistry::records[__SLIM_EXC_THREAD_REGISTRY];
+
+bool ThreadRecord::read(ThreadSnapshot& target, uint32_t& targetGeneration) const noexcept
+{
+	uint32_t before = __atomic_load_n(&this->sequence, __ATOMIC_ACQUIRE);
+	if((before % 2) != 0)
+	{
+		return false;
+	}
+
+	target.owner = load(this->snapshot.owner);
+	target.head = load(this->snapshot.head);
+	target.typeIdentifier = load(this->snapshot.typeIdentifier);
+	target.depth = load(this->snapshot.depth);
+	target.handlingFrames = load(this->snapshot.handlingFrames);
+	target.unwindingFrames = load(this->snapshot.unwindingFrames);
+	targetGeneration = load(this->generation);
+
+	__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	return load(this->sequence) == before;
+}
+
+ThreadRecord* ThreadRegistry::acquire(uintptr_t owner) noexcept
+{
+	for (size_t i = 0; i < capacity; i++)
+	{
+		ThreadRecord& record = records[i];
+		bool expected = false;
+		if(__atomic_compare_exchange_n(&record.used, &expected, true, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+		{
+			record.beginWrite();
+			ThreadRecord::store(record.generation, record.generation + 1);
+			ThreadRecord::store(record.snapshot.owner, owner);
+			record.endWrite();
+			return &record;
+		}
+	}
+	return NULL;
+}
+
+void ThreadRegistry::release(ThreadRecord* record) noexcept
+{
+	if(record == NULL)
+	{
+		return;
+	}
+
+	record->beginWrite();
+	ThreadRecord::store(record->snapshot.owner, uintptr_t(0));
+	ThreadRecord::store(record->snapshot.head, static_cast<const void*>(NULL));
+	ThreadRecord::store(record->snapshot.typeIdentifier, static_cast<const void*>(NULL));
+	ThreadRecord::store(record->snapshot.depth, uint32_t(0));
+	ThreadRecord::store(record->snapshot.handlingFrames, uint32_t(0));
+	ThreadRecord::store(record->snapshot.unwindingFrames, uint32_t(0));
+	record->endWrite();
+
+	__atomic_store_n(&record->used, false, __ATOMIC_RELEASE);
+}
+
+ThreadRegistry::ReadResult ThreadRegistry::readSnapshot(size_t index, ThreadSnapshot& snapshot, uint32_t& generation) noexcept
+{
+	if((index >= capacity) || !__atomic_load_n(&records[index].used, __ATOMIC_ACQUIRE))
+	{
+		return UNUSED;
+	}
+
+	//The owner only writes for a short moment, so a few retries are enough. The reader never blocks the owner.
+	for (uint8_t attempt = 0; attempt < 4; attempt++)
+	{
+		if(records[index].read(snapshot, generation))
+		{
+			return VALID;
+		}
+	}
+	return BUSY;
+}
+
+}//Endnamespace SlimExcLib
+
+#endif //__SLIM_EXC_THREAD_REGISTRY
@@ -0,0 +1,137 @@
+/*
+ * 	Copyright (C) 2023 Philipp Rimmele & Valentin Felder
+ *
+ *	Redistribution and use in source and binary forms, with or without modification, are
+ *	permitted provided that the following conditions are met:
+ *
+ * 	1. Redistributions of source code must retain the above copyright notice, this list
+ *     of conditions and the following disclaimer.
+ *
+ * 	2. Redistributions in binary form must reproduce the above copyright notice, this
+ *     list of conditions and the following disclaimer in the documentation and/or
+ *     other materials provided with the distribution.
+ *
+ *	3. Neither the name of the copyright holder nor the names of its contributors
+ * 	   may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	“AS IS” AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *	TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *	PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *	HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *	SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *	LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *	DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *	THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *	(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ *	THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EXCEPTIONSYSTEM_THREADREGISTRY_HPP_
+#define EXCEPTIONSYSTEM_THREADREGISTRY_HPP_
+
+/*
+ * This file implements the process-wide registry of the ExceptionState-chains of all registered threads.
+ * Each thread publishes a snapshot of its chain (head, depth, number of handling/unwinding frames and the type of the
+ * innermost active exception) into its ThreadRecord, which other threads can read lock-free (seqlock), e.g. the
+ * sampling profiler in "ExceptionSampler.hpp". The threads are never stopped or synchronized with the reader.
+ *
+ * Enable it with "__SLIM_EXC_THREAD_REGISTRY=<maximum number of registered threads>". Every thread which should be
+ * observed acquires a record and returns it from the user-implemented "ExceptionState::getCurrentThreadRecord()":
+ *   static thread_local ThreadRecord* threadRecord = ThreadRegistry::acquire(gettid());
+ *   ThreadRecord* ExceptionState::getCurrentThreadRecord() noexcept { return threadRecord; }
+ * The record has to be released before the thread exits. Threads without record (NULL) are not published.
+ * Frames inside an ExceptionContext (signal-handlers, ISRs) are never published, so the interrupted snapshot stays consistent.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef __SLIM_EXC_THREAD_REGISTRY
+
+namespace SlimExcLib
+{
+
+class ExceptionState;
+class ThreadRegistry;
+
+// Snapshot of the ExceptionState-chain of one thread.
+struct ThreadSnapshot
+{
+	uintptr_t owner;				// Identifier of the thread, given to "ThreadRegistry::acquire()"
+	const void* head;				// Current ExceptionState of the thread
+	const void* typeIdentifier;		// Type of the innermost active exception (see "ExceptionState::getTypeIdentifier()")
+	uint32_t depth;					// Number of ExceptionState-Objects in the chain
+	uint32_t handlingFrames;		// Number of ExceptionState-Objects handling an exception (inside a catch-block)
+	uint32_t unwindingFrames;		// Number of ExceptionState-Objects throwing or rethrowing an exception
+};
+
+class ThreadRecord final
+{
+	friend class ExceptionState;
+	friend class ThreadRegistry;
+
+private:
+	uint32_t sequence = 0;		// Odd while the owning thread writes the snapshot
+	uint32_t generation = 0;	// Incremented on every acquire, so readers can detect a reused record
+	bool used = false;
+	ThreadSnapshot snapshot = {};
+
+	// All fields of the snapshot are accessed with relaxed atomics, ordered by the sequence (seqlock)
+	template <class T> static inline void store(T& field, T value) noexcept
+	{
+		__atomic_store_n(&field, value, __ATOMIC_RELAXED);
+	}
+
+	template <class T> static inline T load(const T& field) noexcept
+	{
+		return __atomic_load_n(&field, __ATOMIC_RELAXED);
+	}
+
+	// Only called by the owning thread
+	inline void beginWrite() noexcept
+	{
+		store(this->sequence, this->sequence + 1);
+		__atomic_thread_fence(__ATOMIC_RELEASE);
+	}
+
+	inline void endWrite() noexcept
+	{
+		__atomic_store_n(&this->sequence, this->sequence + 1, __ATOMIC_RELEASE);
+	}
+
+	// Called by a reader. Returns false if the owner was writing the snapshot at the same time.
+	bool read(ThreadSnapshot& target, uint32_t& targetGeneration) const noexcept;
+};
+
+class ThreadRegistry final
+{
+private:
+	static ThreadRecord records[__SLIM_EXC_THREAD_REGISTRY];
+
+public:
+	static const size_t capacity = __SLIM_EXC_THREAD_REGISTRY;
+
+	enum ReadResult : uint8_t {
+		VALID = 0,		//snapshot was read consistently
+		UNUSED = 1,		//no thread is registered in the record
+		BUSY = 2		//the owner was writing the snapshot during all retries
+	};
+
+	// Claims a free record for the calling thread, returns NULL if all records are in use. Lock-free.
+	static ThreadRecord* acquire(uintptr_t owner) noexcept;
+
+	// Frees the record of the calling thread, its ExceptionState-chain has to be empty.
+	static void release(ThreadRecord* record) noexcept;
+
+	// Reads the snapshot of the record with the given index (< capacity), retrying a few times while the owner writes it.
+	// "generation" changes whenever the record was acquired by another thread.
+	static ReadResult readSnapshot(size_t index, ThreadSnapshot& snapshot, uint32_t& generation) noexcept;
+};
+
+}//Endnamespace SlimExcLib
+
+#endif //__SLIM_EXC_THREAD_REGISTRY
+
+#endif /* EXCEPTIONSYSTEM_THREADREGISTRY_HPP_ */
@@ -0,0 +1,111 @@
+/*
+ * 	Copyright (C) 2023 Philipp Rimmele & Valentin Felder
+ *
+ *	Redistribution and use in source and binary forms, with or without modification, are
+ *	permitted provided that the following conditions are met:
+ *
+ * 	1. Redistributions of source code must retain the above copyright notice, this list
+ *     of conditions and the following disclaimer.
+ *
+ * 	2. Redistributions in binary form must reproduce the above copyright notice, this
+ *     list of conditions and the following disclaimer in the documentation and/or
+ *     other materials provided with the distribution.
+ *
+ *	3. Neither the name of the copyright holder nor the names of its contributors
+ * 	   may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	“AS IS” AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *	TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *	PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *	HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *	SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *	LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *	DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *	THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *	(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ *	THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "ExceptionState.hpp"
+
+#ifdef __SLIM_EXC_THROWN_TYPE_REGISTRY
+
+//Generated by the linker for the section "slimexc_thrown_types". Weak, so they resolve to NULL if nothing is thrown at all.
+extern "C" const SlimExcLib::ThrownTypeRecord __start_slimexc_thrown_types[] __attribute__((weak, visibility("hidden")));
+extern "C" const SlimExcLib::ThrownTypeRecord __stop_slimexc_thrown_types[] __attribute__((weak, visibility("hidden")));
+
+namespace SlimExcLib
+{
+
+namespace
+{
+
+bool isSameSignature(const char* first, const char* second) noexcept
+{
+	if(first == second)
+	{
+		return true;	//Merged by the linker
+	}
+	while((*first != '\0') && (*first == *second))
+	{
+		first++;
+		second++;
+	}
+	return *first == *second;
+}
+
+// Checks if a record of the same type was already seen (only done once at startup, so the quadratic search is fine)
+bool isDuplicate(const ThrownTypeRecord* record) noexcept
+{
+	for (const ThrownTypeRecord* previous = __start_slimexc_thrown_types; previous != record; previous++)
+	{
+		if(isSameSignature(previous->signature, record->signature))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+}//Endnamespace
+
+ThrownTypeReport checkThrownTypes(void(*onOversized)(const ThrownTypeRecord& record) noexcept) noexcept
+{
+	ThrownTypeReport report = {};
+
+	for (const ThrownTypeRecord* record = __start_slimexc_thrown_types; record != __stop_slimexc_thrown_types; record++)
+	{
+		report.recordCount++;
+		if(isDuplicate(record))
+		{
+			continue;
+		}
+		report.typeCount++;
+
+		if(record->size > report.maxSize)
+		{
+			report.maxSize = record->size;
+		}
+		if(record->alignment > report.maxAlignment)
+		{
+			report.maxAlignment = record->alignment;
+		}
+
+		if((record->size > ExceptionState::exceptionBufferSize) || (record->alignment > ExceptionState::exceptionBufferAlignment))
+		{
+			report.oversizedCount++;
+			if(onOversized != nullptr)
+			{
+				onOversized(*record);
+			}
+		}
+	}
+
+	return report;
+}
+
+}//Endnamespace SlimExcLib
+
+#endif //__SLIM_EXC_THROWN_TYPE_REGISTRY
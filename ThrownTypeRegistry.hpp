@@ -0,0 +1,92 @@
+/*
+ * 	Copyright (C) 2023 Philipp Rimmele & Valentin Felder
+ *
+ *	Redistribution and use in source and binary forms, with or without modification, are
+ *	permitted provided that the following conditions are met:
+ *
+ * 	1. Redistributions of source code must retain the above copyright notice, this list
+ *     of conditions and the following disclaimer.
+ *
+ * 	2. Redistributions in binary form must reproduce the above copyright notice, this
+ *     list of conditions and the following disclaimer in the documentation and/or
+ *     other materials provided with the distribution.
+ *
+ *	3. Neither the name of the copyright holder nor the names of its contributors
+ * 	   may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	“AS IS” AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *	TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *	PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *	HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *	SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *	LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *	DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *	THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *	(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ *	THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EXCEPTIONSYSTEM_THROWNTYPEREGISTRY_HPP_
+#define EXCEPTIONSYSTEM_THROWNTYPEREGISTRY_HPP_
+
+/*
+ * This file implements a link-time registry of all types, which are thrown via "ExceptionState::throwException()".
+ * Every instantiation of the throw-path emits a "ThrownTypeRecord" into the linker-section "slimexc_thrown_types",
+ * so the registry causes no runtime-overhead on the throw-path. Throw-sites removed by the optimizer are not recorded.
+ * "checkThrownTypes()" walks over the section (e.g. once at startup) and reports the real maximum size and alignment
+ * of all thrown types and every type that does not fit into the Exceptionbuffer.
+ * With this information "Buffersize" in the plugin-configuration can be set to exactly what the binary throws.
+ *
+ * Enable it by defining __SLIM_EXC_THROWN_TYPE_REGISTRY. A GNU-compatible assembler and linker are required.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace SlimExcLib
+{
+
+// One entry of the linker-section. Written by the assembler, so the layout must only consist of address-sized fields.
+struct ThrownTypeRecord
+{
+	size_t size;			// sizeof() of the thrown type
+	size_t alignment;		// alignof() of the thrown type
+	const char* signature;	// Signature of the registering function, contains the name of the thrown type ("[with T = ...]")
+};
+
+static_assert(sizeof(size_t) == sizeof(void*), "ThrownTypeRecord requires size_t to be address-sized");
+static_assert(sizeof(ThrownTypeRecord) == 3 * sizeof(void*), "ThrownTypeRecord must not contain padding");
+
+struct ThrownTypeReport
+{
+	size_t recordCount;		// Number of records found in the section (one per inlined throw-path, so usually several per type)
+	size_t typeCount;		// Number of distinct thrown types
+	size_t maxSize;			// Largest thrown type in bytes. This is the optimal value for "Buffersize".
+	size_t maxAlignment;	// Largest alignment of all thrown types
+	size_t oversizedCount;	// Number of distinct types, which do not fit into the Exceptionbuffer
+};
+
+// Emits a record for T into the linker-section. Does not generate any instruction.
+template <class T> inline void registerThrownType() noexcept
+{
+	typedef typename std::remove_cv<typename std::remove_reference<T>::type>::type type;
+
+	__asm__ __volatile__(
+		".pushsection slimexc_thrown_types,\"aw\"\n\t"
+		".balign %c3\n\t"
+		".dc.a %c0, %c1, %c2\n\t"
+		".popsection"
+		:
+		: "i"(sizeof(type)), "i"(alignof(type)), "i"(__PRETTY_FUNCTION__), "i"(alignof(ThrownTypeRecord)));
+}
+
+// Walks over all registered types. "onOversized" (can be NULL) is called once for every type which exceeds the size or alignment of the Exceptionbuffer.
+// Records of the same type (emitted by several translation units or inlined throw-paths) are only counted once, found by their signature.
+ThrownTypeReport checkThrownTypes(void(*onOversized)(const ThrownTypeRecord& record) noexcept) noexcept;
+
+}//Endnamespace SlimExcLib
+
+#endif /* EXCEPTIONSYSTEM_THROWNTYPEREGISTRY_HPP_ */
@@ -0,0 +1,104 @@
+/*
+ * 	Copyright (C) 2023 Philipp Rimmele & Valentin Felder
+ *
+ *	Redistribution and use in source and binary forms, with or without modification, are
+ *	permitted provided that the following conditions are met:
+ *
+ * 	1. Redistributions of source code must retain the above copyright notice, this list
+ *     of conditions and the following disclaimer.
+ *
+ * 	2. Redistributions in binary form must reproduce the above copyright notice, this
+ *     list of conditions and the following disclaimer in the documentation and/or
+ *     other materials provided with the distribution.
+ *
+ *	3. Neither the name of the copyright holder nor the names of its contributors
+ * 	   may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	“AS IS” AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *	TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *	PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *	HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *	SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *	LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *	DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *	THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *	(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ *	THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Benchmark of the backtrace-capture (__SLIM_EXC_BACKTRACE_DEPTH = K) of a throw: throw -> catch through a given number
+ * of plain function calls. Plain program, prints nanoseconds per iteration and the number of captured frames.
+ * Arguments: call depth between the catching frame and the throw-site (default 16), iterations (default 10000000).
+ * Build it once without and once per K, e.g. K = 8, and compare the output for the same call depth:
+ *   g++ -std=c++17 -O2 -fno-omit-frame-pointer -I.. BacktraceBench.cpp ../ExceptionState.cpp -o BacktraceBench
+ *   g++ -std=c++17 -O2 -fno-omit-frame-pointer -D__SLIM_EXC_BACKTRACE_DEPTH=8 -I.. BacktraceBench.cpp ../ExceptionState.cpp -o BacktraceBench8
+ */
+
+#include <new>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "ExceptionState.hpp"
+
+using namespace SlimExcLib;
+
+static thread_local ExceptionState* currentExceptionState = NULL;
+ExceptionState* ExceptionState::getCurrentExceptionState() noexcept { return currentExceptionState; }
+void ExceptionState::setCurrentExceptionState(ExceptionState* newInstance) noexcept { currentExceptionState = newInstance; }
+
+struct Payload
+{
+	long value;
+};
+
+static volatile long sink = 0;
+
+// Calls itself "depth" times and throws in the innermost call. The calls have no ExceptionState-frame, like
+// SlimExc-functions without try-block, so only the length of the walked stack depends on "depth".
+__attribute__((noinline)) static void callAndThrow(long value, int depth)
+{
+	if(depth > 0)
+	{
+		callAndThrow(value, depth - 1);
+		sink = sink + 1;	//Prevents the tail-call, every call keeps its stack-frame
+	}
+	else
+	{
+		ExceptionState::getCurrentExceptionState()->throwException(Payload{value});
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int depth = (argc > 1) ? std::atoi(argv[1]) : 16;
+	long iterations = (argc > 2) ? std::atol(argv[2]) : 10000000;
+
+	ExceptionState root(NULL);
+	size_t captured = 0;
+
+	auto start = std::chrono::steady_clock::now();
+	for (long i = 0; i < iterations; i++)
+	{
+		ExceptionState frame(&root);
+		callAndThrow(i, depth);
+		sink = sink + reinterpret_cast<Payload*>(frame.getExceptionReference<Payload>())->value;
+#ifdef __SLIM_EXC_BACKTRACE_DEPTH
+		const void* const* frames;
+		captured = frame.getBacktrace(frames);
+#endif
+	}
+	auto end = std::chrono::steady_clock::now();
+
+#ifdef __SLIM_EXC_BACKTRACE_DEPTH
+	std::printf("K = %3d ", __SLIM_EXC_BACKTRACE_DEPTH);
+#else
+	std::printf("K = off ");
+#endif
+	std::printf("call depth %4d   %8.2f ns per throw -> catch   %zu frames captured\n", depth,
+			std::chrono::duration<double, std::nano>(end - start).count() / iterations, captured);
+	return 0;
+}
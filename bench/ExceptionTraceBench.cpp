@@ -0,0 +1,131 @@
+/*
+ * 	Copyright (C) 2023 Philipp Rimmele & Valentin Felder
+ *
+ *	Redistribution and use in source and binary forms, with or without modification, are
+ *	permitted provided that the following conditions are met:
+ *
+ * 	1. Redistributions of source code must retain the above copyright notice, this list
+ *     of conditions and the following disclaimer.
+ *
+ * 	2. Redistributions in binary form must reproduce the above copyright notice, this
+ *     list of conditions and the following disclaimer in the documentation and/or
+ *     other materials provided with the distribution.
+ *
+ *	3. Neither the name of the copyright holder nor the names of its contributors
+ * 	   may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	“AS IS” AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *	TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *	PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *	HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *	SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *	LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *	DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *	THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *	(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ *	THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Benchmark of the USDT-probes of "ExceptionTrace.hpp" without an attached tracer: throw -> catch with and without
+ * propagation. Plain program, prints nanoseconds per iteration. Build it twice and compare the output, once without and
+ * once with the probes (requires <sys/sdt.h> of systemtap-sdt-dev):
+ *   g++ -std=c++17 -O2 -I.. ExceptionTraceBench.cpp ../ExceptionState.cpp -o ExceptionTraceBench
+ *   g++ -std=c++17 -O2 -D__SLIM_EXC_USDT -I.. ExceptionTraceBench.cpp ../ExceptionState.cpp -o ExceptionTraceBenchUsdt
+ */
+
+#include <new>
+#include <chrono>
+#include <cstdio>
+
+#include "ExceptionState.hpp"
+
+using namespace SlimExcLib;
+
+static thread_local ExceptionState* currentExceptionState = NULL;
+ExceptionState* ExceptionState::getCurrentExceptionState() noexcept { return currentExceptionState; }
+void ExceptionState::setCurrentExceptionState(ExceptionState* newInstance) noexcept { currentExceptionState = newInstance; }
+
+struct Payload
+{
+	long value;
+	explicit Payload(long value) noexcept : value(value) {}
+	~Payload() noexcept {}
+};
+
+static const long iterations = 20000000;
+static volatile long sink = 0;
+
+__attribute__((noinline)) static void throwPayload(long value)
+{
+	ExceptionState::getCurrentExceptionState()->throwException(Payload(value));
+}
+
+// Throws in the innermost of "depth" nested frames, the exception propagates through all of them.
+__attribute__((noinline)) static void throwNested(long value, int depth)
+{
+	ExceptionState frame(ExceptionState::getCurrentExceptionState());
+	if(depth > 1)
+	{
+		throwNested(value, depth - 1);
+	}
+	else
+	{
+		throwPayload(value);
+	}
+}
+
+template <class F> static double measure(F&& body)
+{
+	auto start = std::chrono::steady_clock::now();
+	for (long i = 0; i < iterations; i++)
+	{
+		body(i);
+	}
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+int main()
+{
+	ExceptionState root(NULL);
+
+#ifdef __SLIM_EXC_USDT
+	std::printf("USDT-probes enabled\n");
+#else
+	std::printf("USDT-probes disabled\n");
+#endif
+
+	double time = measure([&root](long i) {
+		ExceptionState frame(&root);
+		sink = sink + i;
+	});
+	std::printf("%-32s %8.2f ns\n", "frame without exception", time);
+
+	time = measure([&root](long i) {
+		ExceptionState frame(&root);
+		throwPayload(i);
+		sink = sink + reinterpret_cast<Payload*>(frame.getExceptionReference<Payload>())->value;
+	});
+	std::printf("%-32s %8.2f ns\n", "throw -> catch", time);
+
+	time = measure([&root](long i) {
+		ExceptionState frame(&root);
+		throwNested(i, 4);
+		sink = sink + reinterpret_cast<Payload*>(frame.getExceptionReference<Payload>())->value;
+	});
+	std::printf("%-32s %8.2f ns\n", "throw -> 4 frames -> catch", time);
+
+	time = measure([&root](long i) {
+		ExceptionState frame(&root);
+		throwPayload(i);
+		frame.getExceptionReference<Payload>();
+		throwPayload(i + 1);	//Thrown inside the handler
+		sink = sink + reinterpret_cast<Payload*>(frame.getExceptionReference<Payload>())->value;
+	});
+	std::printf("%-32s %8.2f ns\n", "throw -> catch -> throw -> catch", time);
+
+	return 0;
+}
@@ -0,0 +1,172 @@
+/*
+ * 	Copyright (C) 2023 Philipp Rimmele & Valentin Felder
+ *
+ *	Redistribution and use in source and binary forms, with or without modification, are
+ *	permitted provided that the following conditions are met:
+ *
+ * 	1. Redistributions of source code must retain the above copyright notice, this list
+ *     of conditions and the following disclaimer.
+ *
+ * 	2. Redistributions in binary form must reproduce the above copyright notice, this
+ *     list of conditions and the following disclaimer in the documentation and/or
+ *     other materials provided with the distribution.
+ *
+ *	3. Neither the name of the copyright holder nor the names of its contributors
+ * 	   may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	“AS IS” AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *	TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *	PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *	HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *	SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *	LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *	DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *	THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *	(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ *	THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Benchmark of "ForeignExceptionBoundary" on the success- and failure-path, compared to the direct call.
+ * Plain program, prints nanoseconds per call. Build (without the SlimExc-plugin, with native exceptions):
+ *   g++ -std=c++17 -O2 -I.. ForeignExceptionBoundaryBench.cpp ../ExceptionState.cpp -o ForeignExceptionBoundaryBench
+ */
+
+#include <new>
+#include <stdexcept>
+#include <typeinfo>
+#include <chrono>
+#include <cstdio>
+
+#include "ForeignExceptionBoundary.hpp"
+
+using namespace SlimExcLib;
+
+static thread_local ExceptionState* currentExceptionState = NULL;
+ExceptionState* ExceptionState::getCurrentExceptionState() noexcept { return currentExceptionState; }
+void ExceptionState::setCurrentExceptionState(ExceptionState* newInstance) noexcept { currentExceptionState = newInstance; }
+
+struct LibraryError
+{
+	int code;
+	explicit LibraryError(int code) : code(code) {}
+	explicit LibraryError(const std::runtime_error&) : code(1) {}
+};
+
+struct NativeLibraryError
+{
+	int code;
+	explicit NativeLibraryError(const LibraryError& error) : code(error.code) {}
+};
+
+// Maps "Native" to LibraryError(2), only used to put mappings in front of the matching one
+template <class Native> struct OtherMapping
+{
+	typedef Native NativeType;
+	typedef LibraryError SlimType;
+	static LibraryError toSlim(const Native&) noexcept { return LibraryError(2); }
+};
+
+typedef ForeignExceptionBoundary<ExceptionMapping<std::runtime_error, LibraryError>> ToSlimExc;
+typedef ForeignExceptionBoundary<OtherMapping<std::bad_alloc>, OtherMapping<std::logic_error>, OtherMapping<std::bad_cast>,
+		ExceptionMapping<std::runtime_error, LibraryError>> ToSlimExcFourth;
+typedef ForeignExceptionBoundary<ExceptionMapping<NativeLibraryError, LibraryError>> ToNative;
+
+static const long successIterations = 50000000;
+static const long failureIterations = 500000;
+static volatile long sink = 0;
+
+__attribute__((noinline)) static int nativeLibrary(int x)
+{
+	if(x < 0)
+	{
+		throw std::runtime_error("negative");
+	}
+	return x + 1;
+}
+
+__attribute__((noinline)) static int slimExcCode(int x)
+{
+	if(x < 0)
+	{
+		ExceptionState::getCurrentExceptionState()->throwException(LibraryError(x));
+		return 0;
+	}
+	return x + 1;
+}
+
+template <class F> static double measure(long iterations, F&& body)
+{
+	auto start = std::chrono::steady_clock::now();
+	for (long i = 0; i < iterations; i++)
+	{
+		body(static_cast<int>(i));
+	}
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+static void report(const char* name, double direct, double adapter)
+{
+	std::printf("%-28s direct %8.2f ns   adapter %8.2f ns   overhead %+8.2f ns\n", name, direct, adapter, adapter - direct);
+}
+
+int main()
+{
+	ExceptionState root(NULL);
+
+	//callNative(): native exceptions into SlimExc. Both run in the ExceptionState-frame of the calling SlimExc-code.
+	double direct = measure(successIterations, [&root](int i) {
+		ExceptionState frame(&root);
+		try { sink = sink + nativeLibrary(i); } catch (const std::runtime_error&) { sink = sink - 1; }
+	});
+	double adapter = measure(successIterations, [&root](int i) {
+		ExceptionState frame(&root);
+		sink = sink + ToSlimExc::callNative(nativeLibrary, i);
+		if(frame.isExceptionThrowing()) { frame.getExceptionReference<LibraryError>(); sink = sink - 1; }
+	});
+	report("callNative success", direct, adapter);
+
+	direct = measure(failureIterations, [&root](int) {
+		ExceptionState frame(&root);
+		try { sink = sink + nativeLibrary(-1); } catch (const std::runtime_error&) { sink = sink - 1; }
+	});
+	adapter = measure(failureIterations, [&root](int) {
+		ExceptionState frame(&root);
+		sink = sink + ToSlimExc::callNative(nativeLibrary, -1);
+		if(frame.isExceptionThrowing()) { frame.getExceptionReference<LibraryError>(); sink = sink - 1; }
+	});
+	report("callNative failure", direct, adapter);
+
+	adapter = measure(failureIterations, [&root](int) {
+		ExceptionState frame(&root);
+		sink = sink + ToSlimExcFourth::callNative(nativeLibrary, -1);
+		if(frame.isExceptionThrowing()) { frame.getExceptionReference<LibraryError>(); sink = sink - 1; }
+	});
+	report("callNative failure, 4th", direct, adapter);
+
+	//callSlimExc(): SlimExc exceptions into native code
+	direct = measure(successIterations, [&root](int i) {
+		ExceptionState frame(&root);
+		sink = sink + slimExcCode(i);
+		if(frame.isExceptionThrowing()) { frame.getExceptionReference<LibraryError>(); sink = sink - 1; }
+	});
+	adapter = measure(successIterations, [](int i) {
+		try { sink = sink + ToNative::callSlimExc(slimExcCode, i); } catch (const NativeLibraryError&) { sink = sink - 1; }
+	});
+	report("callSlimExc success", direct, adapter);
+
+	direct = measure(failureIterations, [&root](int) {
+		ExceptionState frame(&root);
+		sink = sink + slimExcCode(-1);
+		if(frame.isExceptionThrowing()) { frame.getExceptionReference<LibraryError>(); sink = sink - 1; }
+	});
+	adapter = measure(failureIterations, [](int) {
+		try { sink = sink + ToNative::callSlimExc(slimExcCode, -1); } catch (const NativeLibraryError&) { sink = sink - 1; }
+	});
+	report("callSlimExc failure", direct, adapter);
+
+	return 0;
+}
@@ -0,0 +1,183 @@
+/*
+ * 	Copyright (C) 2023 Philipp Rimmele & Valentin Felder
+ *
+ *	Redistribution and use in source and binary forms, with or without modification, are
+ *	permitted provided that the following conditions are met:
+ *
+ * 	1. Redistributions of source code must retain the above copyright notice, this list
+ *     of conditions and the following disclaimer.
+ *
+ * 	2. Redistributions in binary form must reproduce the above copyright notice, this
+ *     list of conditions and the following disclaimer in the documentation and/or
+ *     other materials provided with the distribution.
+ *
+ *	3. Neither the name of the copyright holder nor the names of its contributors
+ * 	   may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	“AS IS” AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *	TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *	PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *	HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *	SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *	LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *	DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *	THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *	(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ *	THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Test of the order of the CauseStack with nested handlers: an exception thrown out of a handler has the handled
+ * exception as direct cause (index 0), followed by its causes and then by the exceptions of the enclosing handlers.
+ * Returns 0 on success.
+ * Build:
+ *   g++ -std=c++17 -O2 -D__SLIM_EXC_RTTI_STRATEGY_SLIM -D__SLIM_EXC_CAUSE_STACK_DEPTH=8 -I.. CauseStackTest.cpp ../ExceptionState.cpp -o CauseStackTest
+ */
+
+#include <new>
+#include <cstdio>
+
+#include "ExceptionState.hpp"
+
+#if (not defined __SLIM_EXC_CAUSE_STACK_DEPTH) || (not defined __SLIM_EXC_RTTI_STRATEGY_SLIM)
+#error "CauseStackTest requires __SLIM_EXC_CAUSE_STACK_DEPTH and __SLIM_EXC_RTTI_STRATEGY_SLIM"
+#endif
+
+using namespace SlimExcLib;
+
+static thread_local ExceptionState* currentExceptionState = NULL;
+static thread_local ExceptionState::CauseStack causeStack;
+ExceptionState* ExceptionState::getCurrentExceptionState() noexcept { return currentExceptionState; }
+void ExceptionState::setCurrentExceptionState(ExceptionState* newInstance) noexcept { currentExceptionState = newInstance; }
+ExceptionState::CauseStack* ExceptionState::getCurrentCauseStack() noexcept { return &causeStack; }
+
+static long livePayloads = 0;
+
+struct Payload
+{
+	long value;
+	explicit Payload(long value) noexcept : value(value) { livePayloads++; }
+	Payload(const Payload& other) noexcept : value(other.value) { livePayloads++; }
+	~Payload() noexcept { livePayloads--; }
+};
+
+static long failures = 0;
+
+#define CHECK(condition) \
+	do { if(!(condition)) { std::printf("FAILED %s:%d: %s\n", __FILE__, __LINE__, #condition); failures++; } } while(0)
+
+// Equivalent of "try { throw Payload(value); }" inside "parent".
+static void throwIn(ExceptionState& parent, long value)
+{
+	ExceptionState frame(&parent);
+	frame.throwException(Payload(value));
+}
+
+// Equivalent of "catch(Payload& p)": returns "p.value".
+static long catchIn(ExceptionState& frame)
+{
+	if(!frame.holdsExceptionOfTypeT<Payload>())
+	{
+		return -1;
+	}
+	return reinterpret_cast<Payload*>(frame.getExceptionReference<Payload>())->value;
+}
+
+static long causeValue(ExceptionState& frame, size_t index)
+{
+	if(!frame.causeHoldsExceptionOfTypeT<Payload>(index))
+	{
+		return -1;
+	}
+	return reinterpret_cast<Payload*>(frame.getCauseReference<Payload>(index))->value;
+}
+
+// F handles 1, the inner G handles 2 and throws 3 out of its handler and out of F's handler.
+static void testNestedHandlers(ExceptionState& root)
+{
+	ExceptionState f(&root);
+	throwIn(f, 1);
+	CHECK(catchIn(f) == 1);
+	{
+		ExceptionState g(&f);
+		throwIn(g, 2);
+		CHECK(catchIn(g) == 2);
+		throwIn(g, 3);
+		CHECK(g.getCauseCount() == 1);
+	}
+	CHECK(catchIn(f) == 3);
+	CHECK(f.getCauseCount() == 2);
+	CHECK(causeValue(f, 0) == 2);
+	CHECK(causeValue(f, 1) == 1);
+	CHECK(*reinterpret_cast<long*>(f.findCause<Payload>()) == 2);
+}
+
+// Like "testNestedHandlers()", but every handled exception already has a cause of its own.
+static void testNestedHandlersWithCauses(ExceptionState& root)
+{
+	ExceptionState f(&root);
+	throwIn(f, 10);
+	CHECK(catchIn(f) == 10);
+	throwIn(f, 11);	//Thrown inside F's handler: 10 becomes its cause
+	CHECK(catchIn(f) == 11);
+	{
+		ExceptionState g(&f);
+		throwIn(g, 20);
+		CHECK(catchIn(g) == 20);
+		throwIn(g, 21);	//Thrown inside G's handler: 20 becomes its cause
+		CHECK(catchIn(g) == 21);
+		{
+			ExceptionState h(&g);
+			throwIn(h, 30);
+			CHECK(catchIn(h) == 30);
+			throwIn(h, 31);	//Leaves the handlers of H, G and F
+		}
+	}
+	CHECK(catchIn(f) == 31);
+	CHECK(f.getCauseCount() == 5);
+	CHECK(causeValue(f, 0) == 30);
+	CHECK(causeValue(f, 1) == 21);
+	CHECK(causeValue(f, 2) == 20);
+	CHECK(causeValue(f, 3) == 11);
+	CHECK(causeValue(f, 4) == 10);
+}
+
+// A rethrow out of the inner handler keeps the order of the causes.
+static void testRethrowInNestedHandler(ExceptionState& root)
+{
+	ExceptionState f(&root);
+	throwIn(f, 1);
+	CHECK(catchIn(f) == 1);
+	{
+		ExceptionState g(&f);
+		throwIn(g, 2);
+		CHECK(catchIn(g) == 2);
+		throwIn(g, 3);
+		CHECK(catchIn(g) == 3);
+		g.rethrow();
+	}
+	CHECK(catchIn(f) == 3);
+	CHECK(f.getCauseCount() == 2);
+	CHECK(causeValue(f, 0) == 2);
+	CHECK(causeValue(f, 1) == 1);
+}
+
+int main()
+{
+	ExceptionState root(NULL);
+
+	testNestedHandlers(root);
+	CHECK(causeStack.getSize() == 0);
+	testNestedHandlersWithCauses(root);
+	CHECK(causeStack.getSize() == 0);
+	testRethrowInNestedHandler(root);
+	CHECK(causeStack.getSize() == 0);
+
+	CHECK(ExceptionState::getCurrentExceptionState() == &root);
+	CHECK(livePayloads == 0);
+
+	std::printf("%s (%ld failures)\n", (failures == 0) ? "PASSED" : "FAILED", failures);
+	return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,163 @@
+/*
+ * 	Copyright (C) 2023 Philipp Rimmele & Valentin Felder
+ *
+ *	Redistribution and use in source and binary forms, with or without modification, are
+ *	permitted provided that the following conditions are met:
+ *
+ * 	1. Redistributions of source code must retain the above copyright notice, this list
+ *     of conditions and the following disclaimer.
+ *
+ * 	2. Redistributions in binary form must reproduce the above copyright notice, this
+ *     list of conditions and the following disclaimer in the documentation and/or
+ *     other materials provided with the distribution.
+ *
+ *	3. Neither the name of the copyright holder nor the names of its contributors
+ * 	   may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	“AS IS” AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *	TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *	PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *	HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *	SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *	LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *	DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *	THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *	(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ *	THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Functional check of "DeferredError::format()": every argument-kind, the special floating-point values, truncation and
+ * unregistered ids. Plain program, returns 0 on success. The buffer size is increased, so a double fits together
+ * with the id.
+ * Build:
+ *   g++ -std=c++17 -O2 -D__SLIM_EXC_BUFFER_SIZE=16 -I.. DeferredErrorTest.cpp ../DeferredError.cpp -o DeferredErrorTest
+ */
+
+#include <new>
+#include <cstdio>
+#include <cstring>
+#include <cfloat>
+
+#include "DeferredError.hpp"
+
+#if (__SLIM_EXC_BUFFER_SIZE < 16)
+#error "DeferredErrorTest requires __SLIM_EXC_BUFFER_SIZE >= 16"
+#endif
+
+using namespace SlimExcLib;
+
+static int failures = 0;
+
+// Formats "error" and compares it with "expected"
+static void check(const DeferredError& error, const char* expected, int line)
+{
+	char text[128];
+	size_t length = error.format(text, sizeof(text));
+	if((std::strcmp(text, expected) != 0) || (length != std::strlen(expected)))
+	{
+		std::printf("FAILED %s:%d: \"%s\" (length %zu), expected \"%s\"\n", __FILE__, line, text, length, expected);
+		failures++;
+	}
+}
+
+#define CHECK_FORMAT(error, expected) check(error, expected, __LINE__)
+
+#define CHECK(condition) \
+	do { if(!(condition)) { std::printf("FAILED %s:%d: %s\n", __FILE__, __LINE__, #condition); failures++; } } while(0)
+
+enum class Color : uint8_t { RED = 1, BLUE = 2 };
+
+static void testIntegers()
+{
+	CHECK_FORMAT(SLIM_EXC_DEFERRED_ERROR("{}", static_cast<int8_t>(-128)), "-128");
+	CHECK_FORMAT(SLIM_EXC_DEFERRED_ERROR("{}", static_cast<int16_t>(-32768)), "-32768");
+	CHECK_FORMAT(SLIM_EXC_DEFERRED_ERROR("{}", static_cast<int32_t>(INT32_MIN)), "-2147483648");
+	CHECK_FORMAT(SLIM_EXC_DEFERRED_ERROR("{}", static_cast<int64_t>(INT64_MIN)), "-9223372036854775808");
+	CHECK_FORMAT(SLIM_EXC_DEFERRED_ERROR("{}", static_cast<int64_t>(0)), "0");
+	CHECK_FORMAT(SLIM_EXC_DEFERRED_ERROR("{}", static_cast<uint8_t>(255)), "255");
+	CHECK_FORMAT(SLIM_EXC_DEFERRED_ERROR("{}", static_cast<uint16_t>(65535)), "65535");
+	CHECK_FORMAT(SLIM_EXC_DEFERRED_ERROR("{}", static_cast<uint32_t>(UINT32_MAX)), "4294967295");
+	CHECK_FORMAT(SLIM_EXC_DEFERRED_ERROR("{}", static_cast<uint64_t>(UINT64_MAX)), "18446744073709551615");
+	CHECK_FORMAT(SLIM_EXC_DEFERRED_ERROR("color {}", Color::BLUE), "color 2");
+}
+
+static void testOtherKinds()
+{
+	CHECK_FORMAT(SLIM_EXC_DEFERRED_ERROR("{} {}", true, false), "true false");
+	CHECK_FORMAT(SLIM_EXC_DEFERRED_ERROR("<{}>", 'x'), "<x>");
+	CHECK_FORMAT(SLIM_EXC_DEFERRED_ERROR("{}", reinterpret_cast<const void*>(0x1234)), "0x1234");
+	CHECK_FORMAT(SLIM_EXC_DEFERRED_ERROR("{}", static_cast<int*>(NULL)), "0x0");
+}
+
+static void testFloatingPoint()
+{
+	CHECK_FORMAT(SLIM_EXC_DEFERRED_ERROR("{}", 1.5f), "1.500000");
+	CHECK_FORMAT(SLIM_EXC_DEFERRED_ERROR("{}", -0.25), "-0.250000");
+	CHECK_FORMAT(SLIM_EXC_DEFERRED_ERROR("{}", 0.9999996), "1.000000");
+	CHECK_FORMAT(SLIM_EXC_DEFERRED_ERROR("{}", 1e-9), "0.000000");
+	CHECK_FORMAT(SLIM_EXC_DEFERRED_ERROR("{}", 123456789012345678.0), "123456789012345680.000000");
+	CHECK_FORMAT(SLIM_EXC_DEFERRED_ERROR("{}", 18446744073709551616.0), "1.844674e+19");
+	CHECK_FORMAT(SLIM_EXC_DEFERRED_ERROR("{}", -1e300), "-1.000000e+300");
+	CHECK_FORMAT(SLIM_EXC_DEFERRED_ERROR("{}", 9.9999999e25), "1.000000e+26");
+	CHECK_FORMAT(SLIM_EXC_DEFERRED_ERROR("{}", DBL_MAX), "1.797693e+308");
+	CHECK_FORMAT(SLIM_EXC_DEFERRED_ERROR("{}", FLT_MAX), "3.402823e+38");
+	CHECK_FORMAT(SLIM_EXC_DEFERRED_ERROR("{}", __builtin_inf()), "inf");
+	CHECK_FORMAT(SLIM_EXC_DEFERRED_ERROR("{}", -__builtin_inff()), "-inf");
+	CHECK_FORMAT(SLIM_EXC_DEFERRED_ERROR("{}", __builtin_nan("")), "nan");
+}
+
+static void testTemplate()
+{
+	CHECK_FORMAT(SLIM_EXC_DEFERRED_ERROR("no arguments"), "no arguments");
+	CHECK_FORMAT(SLIM_EXC_DEFERRED_ERROR("a {} b {}", 1), "a 1 b {}");	//More placeholders than arguments
+	CHECK_FORMAT(SLIM_EXC_DEFERRED_ERROR("{", 1), "{");
+	CHECK_FORMAT(SLIM_EXC_DEFERRED_ERROR("record {} has invalid length {}", static_cast<uint32_t>(7), static_cast<uint16_t>(300)),
+			"record 7 has invalid length 300");
+
+	DeferredError error = SLIM_EXC_DEFERRED_ERROR("value {}", 5);
+	CHECK(error.getRecord() != NULL);
+	CHECK(std::strcmp(error.getRecord()->text, "value {}") == 0);
+	CHECK(error.getRecord()->id == error.getId());
+	CHECK(SLIM_EXC_DEFERRED_ERROR("value {}", 5u).getId() != error.getId());	//The argument-kinds are part of the id
+}
+
+static void testTruncation()
+{
+	DeferredError error = SLIM_EXC_DEFERRED_ERROR("value {}", 12345);
+
+	char text[8];
+	CHECK(error.format(text, sizeof(text)) == 11);
+	CHECK(std::strcmp(text, "value 1") == 0);
+
+	text[0] = 'x';
+	CHECK(error.format(text, 1) == 11);
+	CHECK(text[0] == '\0');
+
+	text[0] = 'x';
+	CHECK(error.format(text, 0) == 11);
+	CHECK(text[0] == 'x');	//Nothing is written
+}
+
+static void testUnregistered()
+{
+	DeferredError error(0xdeadbeefu, 3);	//Created without SLIM_EXC_DEFERRED_ERROR, so not in the linker-section
+	CHECK(error.getId() == 0xdeadbeefu);
+	CHECK(error.getRecord() == NULL);
+	CHECK_FORMAT(error, "<unregistered message 0xdeadbeef>");
+}
+
+int main()
+{
+	testIntegers();
+	testOtherKinds();
+	testFloatingPoint();
+	testTemplate();
+	testTruncation();
+	testUnregistered();
+
+	std::printf("%s (%d failures)\n", (failures == 0) ? "PASSED" : "FAILED", failures);
+	return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,146 @@
+/*
+ * 	Copyright (C) 2023 Philipp Rimmele & Valentin Felder
+ *
+ *	Redistribution and use in source and binary forms, with or without modification, are
+ *	permitted provided that the following conditions are met:
+ *
+ * 	1. Redistributions of source code must retain the above copyright notice, this list
+ *     of conditions and the following disclaimer.
+ *
+ * 	2. Redistributions in binary form must reproduce the above copyright notice, this
+ *     list of conditions and the following disclaimer in the documentation and/or
+ *     other materials provided with the distribution.
+ *
+ *	3. Neither the name of the copyright holder nor the names of its contributors
+ * 	   may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	“AS IS” AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *	TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *	PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *	HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *	SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *	LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *	DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *	THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *	(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ *	THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Stress test of "ExceptionContext" with real signals (Linux): the main loop throws and catches, while a timer
+ * signal-handler throws and catches inside an ExceptionContextScope. After every step the main loop checks, that the
+ * current ExceptionState, the caught payload and the CauseStack were not changed by the handler. Returns 0 on success.
+ * Build (the first argument sets the number of iterations):
+ *   g++ -std=c++17 -O2 -D__SLIM_EXC_RTTI_STRATEGY_SLIM -D__SLIM_EXC_CAUSE_STACK_DEPTH=4 -I.. ExceptionContextSignalTest.cpp ../ExceptionState.cpp ../ExceptionContext.cpp -o ExceptionContextSignalTest
+ */
+
+#include <new>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <sys/time.h>
+
+#include "ExceptionContext.hpp"
+
+#if (not defined __SLIM_EXC_CAUSE_STACK_DEPTH) || (not defined __SLIM_EXC_RTTI_STRATEGY_SLIM)
+#error "ExceptionContextSignalTest requires __SLIM_EXC_CAUSE_STACK_DEPTH and __SLIM_EXC_RTTI_STRATEGY_SLIM"
+#endif
+
+using namespace SlimExcLib;
+
+//initial-exec, so the accesses are async-signal-safe
+static thread_local ExceptionState* currentExceptionState __attribute__((tls_model("initial-exec"))) = NULL;
+static thread_local ExceptionState::CauseStack causeStack __attribute__((tls_model("initial-exec")));
+ExceptionState* ExceptionState::getCurrentExceptionState() noexcept { return currentExceptionState; }
+void ExceptionState::setCurrentExceptionState(ExceptionState* newInstance) noexcept { currentExceptionState = newInstance; }
+ExceptionState::CauseStack* ExceptionState::getCurrentCauseStack() noexcept { return &causeStack; }
+
+static volatile sig_atomic_t livePayloads = 0;
+
+struct Payload
+{
+	long value;
+	explicit Payload(long value) noexcept : value(value) { livePayloads = livePayloads + 1; }
+	Payload(const Payload& other) noexcept : value(other.value) { livePayloads = livePayloads + 1; }
+	~Payload() noexcept { livePayloads = livePayloads - 1; }
+};
+
+static ExceptionContext signalContext;
+static volatile long handlerRuns = 0;
+static volatile long handlerFailures = 0;
+
+static void onTimer(int)
+{
+	ExceptionContextScope scope(signalContext);
+
+	ExceptionState frame(ExceptionState::getCurrentExceptionState());
+	frame.throwException(Payload(-1));
+	frame.getExceptionReference<Payload>();
+	frame.throwException(Payload(-2));	//Thrown inside the handler: Payload(-1) becomes its cause
+
+	if(!frame.holdsExceptionOfTypeT<Payload>() || (reinterpret_cast<Payload*>(frame.getExceptionReference<Payload>())->value != -2)
+			|| (frame.getCauseCount() != 1) || (reinterpret_cast<Payload*>(frame.getCauseReference<Payload>(0))->value != -1))
+	{
+		handlerFailures = handlerFailures + 1;
+	}
+	handlerRuns = handlerRuns + 1;
+}
+
+static long failures = 0;
+
+#define CHECK(condition) \
+	do { if(!(condition)) { if(failures < 10) { std::printf("FAILED %s:%d (iteration %ld): %s\n", __FILE__, __LINE__, i, #condition); } failures++; } } while(0)
+
+int main(int argc, char** argv)
+{
+	long iterations = (argc > 1) ? std::atol(argv[1]) : 20000000;
+
+	std::signal(SIGALRM, onTimer);
+	itimerval timer = {{0, 20}, {0, 20}};
+	setitimer(ITIMER_REAL, &timer, NULL);
+
+	ExceptionState root(NULL);
+
+	for (long i = 0; i < iterations; i++)
+	{
+		{
+			ExceptionState outer(&root);
+			{
+				ExceptionState inner(&outer);
+				inner.throwException(Payload(i));
+			}
+			CHECK(outer.holdsExceptionOfTypeT<Payload>());
+			Payload* caught = reinterpret_cast<Payload*>(outer.getExceptionReference<Payload>());
+			CHECK(caught->value == i);
+			CHECK(ExceptionState::getCurrentExceptionState() == &outer);
+			CHECK(causeStack.getSize() == 0);
+
+			{
+				ExceptionState inner(&outer);
+				inner.throwException(Payload(i + 1));	//Thrown inside the handler: Payload(i) becomes its cause
+			}
+			CHECK(outer.holdsExceptionOfTypeT<Payload>());
+			CHECK(reinterpret_cast<Payload*>(outer.getExceptionReference<Payload>())->value == i + 1);
+			CHECK(outer.getCauseCount() == 1);
+			CHECK(reinterpret_cast<Payload*>(outer.getCauseReference<Payload>(0))->value == i);
+			CHECK(causeStack.getSize() == 1);
+			CHECK(ExceptionState::getCurrentExceptionState() == &outer);
+		}
+		CHECK(ExceptionState::getCurrentExceptionState() == &root);
+		CHECK(causeStack.getSize() == 0);
+		CHECK(!root.isExceptionThrowing());
+	}
+
+	timer = {};
+	setitimer(ITIMER_REAL, &timer, NULL);
+
+	long i = iterations;
+	CHECK(handlerRuns > 0);
+	CHECK(handlerFailures == 0);
+	CHECK(livePayloads == 0);
+
+	std::printf("%s (%ld iterations, %ld signals, %ld failures)\n", (failures == 0) ? "PASSED" : "FAILED", iterations, handlerRuns, failures);
+	return (failures == 0) ? 0 : 1;
+}
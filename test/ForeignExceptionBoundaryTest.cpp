@@ -0,0 +1,178 @@
+/*
+ * 	Copyright (C) 2023 Philipp Rimmele & Valentin Felder
+ *
+ *	Redistribution and use in source and binary forms, with or without modification, are
+ *	permitted provided that the following conditions are met:
+ *
+ * 	1. Redistributions of source code must retain the above copyright notice, this list
+ *     of conditions and the following disclaimer.
+ *
+ * 	2. Redistributions in binary form must reproduce the above copyright notice, this
+ *     list of conditions and the following disclaimer in the documentation and/or
+ *     other materials provided with the distribution.
+ *
+ *	3. Neither the name of the copyright holder nor the names of its contributors
+ * 	   may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	“AS IS” AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *	TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *	PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *	HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *	SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *	LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *	DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *	THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *	(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ *	THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Functional check of "ForeignExceptionBoundary" in both directions. Plain program, returns 0 on success.
+ * Build (without the SlimExc-plugin, with native exceptions):
+ *   g++ -std=c++17 -O2 -I.. ForeignExceptionBoundaryTest.cpp ../ExceptionState.cpp -o ForeignExceptionBoundaryTest
+ */
+
+#include <new>
+#include <stdexcept>
+#include <cstdio>
+
+#include "ForeignExceptionBoundary.hpp"
+
+using namespace SlimExcLib;
+
+static thread_local ExceptionState* currentExceptionState = NULL;
+ExceptionState* ExceptionState::getCurrentExceptionState() noexcept { return currentExceptionState; }
+void ExceptionState::setCurrentExceptionState(ExceptionState* newInstance) noexcept { currentExceptionState = newInstance; }
+
+static int liveErrors = 0;
+
+struct LibraryError
+{
+	int code;
+	explicit LibraryError(int code) : code(code) { liveErrors++; }
+	explicit LibraryError(const std::runtime_error&) : code(42) { liveErrors++; }
+	LibraryError(const LibraryError& other) : code(other.code) { liveErrors++; }
+	~LibraryError() { liveErrors--; }
+};
+
+struct NativeLibraryError : std::runtime_error
+{
+	int code;
+	explicit NativeLibraryError(const LibraryError& error) : std::runtime_error("LibraryError"), code(error.code) {}
+};
+
+// Custom mapping: only converts in the native -> SlimExc direction
+struct LogicErrorMapping
+{
+	typedef std::logic_error NativeType;
+	typedef int SlimType;
+	static int toSlim(const std::logic_error&) noexcept { return 5; }
+};
+
+typedef ForeignExceptionBoundary<LogicErrorMapping, ExceptionMapping<std::runtime_error, LibraryError>> ToSlimExc;
+typedef ForeignExceptionBoundary<ExceptionMapping<NativeLibraryError, LibraryError>> ToNative;
+
+static int failures = 0;
+
+#define CHECK(condition) \
+	do { if(!(condition)) { std::printf("FAILED %s:%d: %s\n", __FILE__, __LINE__, #condition); failures++; } } while(0)
+
+static int nativeLibrary(int x)
+{
+	if(x == -1)
+	{
+		throw std::runtime_error("negative");
+	}
+	if(x == -2)
+	{
+		throw std::logic_error("logic");
+	}
+	if(x == -3)
+	{
+		throw std::out_of_range("range");
+	}
+	if(x == -4)
+	{
+		throw std::range_error("range");
+	}
+	return x * 2;
+}
+
+static int slimExcCode(int x)
+{
+	if(x < 0)
+	{
+		ExceptionState::getCurrentExceptionState()->throwException(LibraryError(x));
+		return 0;
+	}
+	return x + 1;
+}
+
+static void testNativeToSlimExc(ExceptionState& root)
+{
+	{
+		ExceptionState frame(&root);
+		CHECK(ToSlimExc::callNative(nativeLibrary, 3) == 6);
+		CHECK(!frame.isExceptionThrowing());
+	}
+	{
+		ExceptionState frame(&root);
+		CHECK(ToSlimExc::callNative(nativeLibrary, -1) == 0);	//Default-constructed result together with the exception
+		CHECK(frame.isExceptionThrowing());
+		CHECK(frame.holdsExceptionOfTypeT<LibraryError>());
+		CHECK(reinterpret_cast<LibraryError*>(frame.getExceptionReference<LibraryError>())->code == 42);
+	}
+	{
+		ExceptionState frame(&root);
+		ToSlimExc::callNative(nativeLibrary, -2);
+		CHECK(frame.holdsExceptionOfTypeT<int>());
+		CHECK(*reinterpret_cast<int*>(frame.getExceptionReference<int>()) == 5);
+	}
+	{//Derived native types use the first matching mapping
+		ExceptionState frame(&root);
+		ToSlimExc::callNative(nativeLibrary, -3);
+		CHECK(frame.holdsExceptionOfTypeT<int>());
+		CHECK(*reinterpret_cast<int*>(frame.getExceptionReference<int>()) == 5);
+	}
+	{
+		ExceptionState frame(&root);
+		ToSlimExc::callNative(nativeLibrary, -4);
+		CHECK(frame.holdsExceptionOfTypeT<LibraryError>());
+		CHECK(reinterpret_cast<LibraryError*>(frame.getExceptionReference<LibraryError>())->code == 42);
+	}
+	CHECK(liveErrors == 0);
+	CHECK(ExceptionState::getCurrentExceptionState() == &root);
+}
+
+static void testSlimExcToNative(ExceptionState& root)
+{
+	CHECK(ToNative::callSlimExc(slimExcCode, 1) == 2);
+
+	bool caught = false;
+	try
+	{
+		ToNative::callSlimExc(slimExcCode, -7);
+	}
+	catch (const NativeLibraryError& error)
+	{
+		caught = true;
+		CHECK(error.code == -7);
+		CHECK(ExceptionState::getCurrentExceptionState() == &root);	//The frame of "callSlimExc()" is unwound
+	}
+	CHECK(caught);
+	CHECK(liveErrors == 0);	//The SlimExc exception is destructed by the unwound frame
+	CHECK(!root.isExceptionThrowing());
+}
+
+int main()
+{
+	ExceptionState root(NULL);
+
+	testNativeToSlimExc(root);
+	testSlimExcToNative(root);
+
+	std::printf("%s (%d failures)\n", (failures == 0) ? "PASSED" : "FAILED", failures);
+	return (failures == 0) ? 0 : 1;
+}
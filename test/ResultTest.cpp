@@ -0,0 +1,235 @@
+/*
+ * 	Copyright (C) 2023 Philipp Rimmele & Valentin Felder
+ *
+ *	Redistribution and use in source and binary forms, with or without modification, are
+ *	permitted provided that the following conditions are met:
+ *
+ * 	1. Redistributions of source code must retain the above copyright notice, this list
+ *     of conditions and the following disclaimer.
+ *
+ * 	2. Redistributions in binary form must reproduce the above copyright notice, this
+ *     list of conditions and the following disclaimer in the documentation and/or
+ *     other materials provided with the distribution.
+ *
+ *	3. Neither the name of the copyright holder nor the names of its contributors
+ * 	   may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	“AS IS” AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *	TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *	PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *	HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *	SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *	LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *	DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *	THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *	(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ *	THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Functional check of "Result": "invoke()", "fromActiveException()", "raise()" and the termination of a rethrow after
+ * the exception was taken out of its handler. Plain program (Linux, the terminating cases run in a child process),
+ * returns 0 on success.
+ * Build:
+ *   g++ -std=c++17 -O2 -D__SLIM_EXC_RTTI_STRATEGY_SLIM -I.. ResultTest.cpp ../ExceptionState.cpp -o ResultTest
+ */
+
+#include <new>
+#include <csignal>
+#include <cstdio>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "Result.hpp"
+
+#ifndef __SLIM_EXC_RTTI_STRATEGY_SLIM
+#error "ResultTest requires __SLIM_EXC_RTTI_STRATEGY_SLIM"
+#endif
+
+using namespace SlimExcLib;
+
+static thread_local ExceptionState* currentExceptionState = NULL;
+ExceptionState* ExceptionState::getCurrentExceptionState() noexcept { return currentExceptionState; }
+void ExceptionState::setCurrentExceptionState(ExceptionState* newInstance) noexcept { currentExceptionState = newInstance; }
+
+static long liveErrors = 0;
+
+struct ErrorA
+{
+	long value;
+	explicit ErrorA(long value) noexcept : value(value) { liveErrors++; }
+	ErrorA(const ErrorA& other) noexcept : value(other.value) { liveErrors++; }
+	~ErrorA() noexcept { liveErrors--; }
+};
+
+struct ErrorB
+{
+	long value;
+	explicit ErrorB(long value) noexcept : value(value) { liveErrors++; }
+	ErrorB(const ErrorB& other) noexcept : value(other.value) { liveErrors++; }
+	~ErrorB() noexcept { liveErrors--; }
+};
+
+typedef Result<long, ErrorB, ErrorA> LongResult;
+
+static int failures = 0;
+
+#define CHECK(condition) \
+	do { if(!(condition)) { std::printf("FAILED %s:%d: %s\n", __FILE__, __LINE__, #condition); failures++; } } while(0)
+
+static long succeed(long value)
+{
+	return value * 2;
+}
+
+static long failA(long value)
+{
+	ExceptionState::getCurrentExceptionState()->throwException(ErrorA(value));
+	return 0;
+}
+
+static long failInt(long value)
+{
+	ExceptionState::getCurrentExceptionState()->throwException(static_cast<int>(value));
+	return 0;
+}
+
+static long rethrowActive(long)
+{
+	ExceptionState::getCurrentExceptionState()->rethrow();
+	return 0;
+}
+
+static void testInvoke(ExceptionState& root)
+{
+	{
+		ExceptionState frame(&root);
+		LongResult result = LongResult::invoke(succeed, 4);
+		CHECK(!frame.isExceptionThrowing());
+		CHECK(result.hasValue() && (result.getValue() == 8));
+		CHECK(!result.hasError());
+	}
+	{
+		ExceptionState frame(&root);
+		LongResult result = LongResult::invoke(failA, 5);
+		CHECK(!frame.isExceptionThrowing());	//Taken out of the frame of "invoke()", nothing propagates
+		CHECK(ExceptionState::getCurrentExceptionState() == &frame);
+		CHECK(result.hasError() && (result.getErrorIndex() == 1));
+		CHECK(result.holdsErrorOfTypeT<ErrorA>() && !result.holdsErrorOfTypeT<ErrorB>());
+		CHECK(reinterpret_cast<ErrorA*>(result.getErrorReference<ErrorA>())->value == 5);
+		CHECK(liveErrors == 1);
+
+		LongResult moved(static_cast<LongResult&&>(result));
+		CHECK(!result.hasError() && moved.hasError());
+		CHECK(liveErrors == 1);
+	}
+	CHECK(liveErrors == 0);
+	{//No matching type: propagated to the caller
+		ExceptionState frame(&root);
+		LongResult result = LongResult::invoke(failInt, 6);
+		CHECK(!result.hasValue() && !result.hasError());
+		CHECK(frame.isExceptionThrowing());
+		CHECK(frame.holdsExceptionOfTypeT<int>());
+		CHECK(*reinterpret_cast<int*>(frame.getExceptionReference<int>()) == 6);
+	}
+	{//Rethrow of an exception of an outer handler: propagated, the handler still owns it
+		ExceptionState frame(&root);
+		frame.throwException(ErrorA(7));
+		CHECK(reinterpret_cast<ErrorA*>(frame.getExceptionReference<ErrorA>())->value == 7);
+		LongResult result = LongResult::invoke(rethrowActive, 0);
+		CHECK(!result.hasValue() && !result.hasError());
+		CHECK(frame.isExceptionThrowing());
+		CHECK(frame.holdsExceptionOfTypeT<ErrorA>());
+		CHECK(reinterpret_cast<ErrorA*>(frame.getExceptionReference<ErrorA>())->value == 7);
+		CHECK(liveErrors == 1);
+	}
+	CHECK(liveErrors == 0);
+}
+
+static void testFromActiveExceptionAndRaise(ExceptionState& root)
+{
+	ExceptionState frame(&root);
+	frame.throwException(ErrorB(8));
+	CHECK(frame.holdsExceptionOfTypeT<ErrorB>());
+	frame.getExceptionReference<ErrorB>();
+
+	LongResult result = LongResult::fromActiveException();
+	CHECK(result.hasError() && (result.getErrorIndex() == 0));
+	CHECK(reinterpret_cast<ErrorB*>(result.getErrorReference<ErrorB>())->value == 8);
+	CHECK(liveErrors == 1);
+
+	{
+		ExceptionState inner(&frame);
+		result.raise();
+		CHECK(inner.isExceptionThrowing());
+		CHECK(!result.hasError());
+		CHECK(liveErrors == 1);	//Moved, not copied
+		CHECK(inner.holdsExceptionOfTypeT<ErrorB>());
+		CHECK(reinterpret_cast<ErrorB*>(inner.getExceptionReference<ErrorB>())->value == 8);
+	}
+	CHECK(liveErrors == 0);
+	CHECK(ExceptionState::getCurrentExceptionState() == &frame);
+}
+
+// Runs "body" in a child process, returns true if it was terminated with SIGABRT (std::terminate()).
+template <class F> static bool terminates(F&& body)
+{
+	std::fflush(stdout);
+	pid_t child = fork();
+	if(child == 0)
+	{
+		std::freopen("/dev/null", "w", stderr);	//Hides the message of std::terminate()
+		body();
+		_exit(0);
+	}
+	int status = 0;
+	waitpid(child, &status, 0);
+	return WIFSIGNALED(status) && (WTERMSIG(status) == SIGABRT);
+}
+
+static void testRethrowAfterTake(ExceptionState& root)
+{
+	CHECK(terminates([&root]() {	//"throw;" after "fromActiveException()"
+		ExceptionState frame(&root);
+		frame.throwException(ErrorA(9));
+		frame.getExceptionReference<ErrorA>();
+		LongResult result = LongResult::fromActiveException();
+		frame.rethrow();
+	}));
+	CHECK(terminates([&root]() {	//"throw error;" of the caught reference after "fromActiveException()"
+		ExceptionState frame(&root);
+		frame.throwException(ErrorA(10));
+		ErrorA& error = *reinterpret_cast<ErrorA*>(frame.getExceptionReference<ErrorA>());
+		LongResult result = LongResult::fromActiveException();
+		frame.throwException(error);
+	}));
+	CHECK(terminates([&root]() {	//"fromActiveException()" outside of a catch-block
+		ExceptionState frame(&root);
+		LongResult result = LongResult::fromActiveException();
+	}));
+	CHECK(!terminates([&root]() {	//"throw error;" without "fromActiveException()" is an explicit rethrow
+		ExceptionState frame(&root);
+		frame.throwException(ErrorA(11));
+		ErrorA& error = *reinterpret_cast<ErrorA*>(frame.getExceptionReference<ErrorA>());
+		frame.throwException(error);
+		frame.getExceptionReference<ErrorA>();
+	}));
+}
+
+int main()
+{
+	ExceptionState root(NULL);
+
+	testInvoke(root);
+	testFromActiveExceptionAndRaise(root);
+	testRethrowAfterTake(root);
+
+	CHECK(ExceptionState::getCurrentExceptionState() == &root);
+	CHECK(!root.isExceptionThrowing());
+	CHECK(liveErrors == 0);
+
+	std::printf("%s (%d failures)\n", (failures == 0) ? "PASSED" : "FAILED", failures);
+	return (failures == 0) ? 0 : 1;
+}